@@ -21,7 +21,20 @@
 
 
 
+#include <stddef.h>
+
+
+
+/*
+ * Define MORSE_FREESTANDING for small targets without heap (see Makefile.embedded)
+ * Then nothing needs the bst library or malloc(): the BisTree dictionaries and
+ * Everything built on them are left out, and the conversions of the
+ * "Dictionary-free conversions" section below work from const tables only
+*/
+
+#ifndef MORSE_FREESTANDING
 #include <bst.h>
+#endif
 
 
 #define MORSE_DOT '.'
@@ -38,6 +51,119 @@
 
 
 
+/*
+ * Separator dialect of a morse string
+ * The native dialect of this library writes ".-/-...|-.-." for "AB C"
+ * The standard dialect writes ".- -... / -.-." which most external sources use
+ *
+ * Encoder writes dotGlyph, dashGlyph, letterSeparator and wordSeparator as given
+ * Decoder additionally accepts the plain '.' and '-', the middle dot (U+00B7) and
+ * the minus sign (U+2212) as UTF-8, blanks around the word separator are optional,
+ * and a run of at least wordGapSpaces blanks is a word gap as well (0 disables)
+*/
+
+typedef struct MorseDialect_ {
+
+	const char *dotGlyph;
+	const char *dashGlyph;
+	const char *letterSeparator;
+	const char *wordSeparator;
+	int wordGapSpaces;
+
+} MorseDialect;
+
+extern const MorseDialect morse_nativeDialect;			/* "." "-" "/" "|" */
+extern const MorseDialect morse_standardDialect;		/* "." "-" " " " / ", 3 blanks */
+
+
+
+
+
+
+/*
+ * Output targets other than one contiguous array
+ *
+ * MorseSegment	- One piece of caller owned memory in a scatter-gather list (iovec)
+ * MorseSink		- A writer callback, called with every block of output as it fills
+ *				  block / blockSize name the caller's block buffer, if block is 0
+ *				  a small internal block is used. write() returns 0 to go on, or
+ *				  non zero to abort the conversion
+*/
+
+typedef struct MorseSegment_ {
+
+	char *base;
+	int length;
+
+} MorseSegment;
+
+typedef int (*MorseSinkFunction)(void *userData, const char *block, int blockLen);
+
+typedef struct MorseSink_ {
+
+	MorseSinkFunction write;
+	void *userData;
+	char *block;
+	int blockSize;
+
+} MorseSink;
+
+
+
+
+
+/*
+ * Pluggable allocator, used for every allocation the library makes on its own
+ * (Dictionary keys and values, channel bank memory, pipeline rings). The *With()
+ * Creation functions take one, all others use morse_defaultAllocator (malloc / free)
+ *
+ * The allocator must outlive everything created with it. Note that the nodes
+ * Of BisTree itself are still allocated by the bst library, a MorseDictionary
+ * (Below) is the dictionary which comes wholly from the allocator
+*/
+
+typedef struct MorseAllocator_ {
+
+	void *(*allocate)(void *userData, size_t size);		/* Returns 0 on failure */
+	void (*release)(void *userData, void *memory);
+	void *userData;
+
+} MorseAllocator;
+
+#ifndef MORSE_FREESTANDING
+extern const MorseAllocator morse_defaultAllocator;
+#endif
+
+
+
+/*
+ * Bump arena over one caller supplied block of memory
+ * Allocation only moves an offset forward, single releases are ignored and
+ * morse_resetArena() gives back everything at once in O(1)
+ *
+ * The block should be aligned for any type (eg. from malloc or a static double array)
+*/
+
+typedef struct MorseArena_ {
+
+	char *memory;
+	size_t capacity;
+	size_t used;
+
+} MorseArena;
+
+void morse_initArena(MorseArena *arena, void *memory, size_t capacity);
+
+void morse_resetArena(MorseArena *arena);
+
+void morse_getArenaAllocator(MorseArena *arena, MorseAllocator *allocator);
+
+
+
+
+
+#ifndef MORSE_FREESTANDING
+
 /*
  * Below FOUR (4) functions build Dictionary data structures
  * These data structures will be used for searching against a specified key
@@ -53,6 +179,8 @@
 
 int morse_createAsciiToMorseMapping(BisTree *textToMorse);
 
+int morse_createAsciiToMorseMappingEx(BisTree *textToMorse, const MorseDialect *dialect);
+
 int morse_createMorseToAsciiMapping(BisTree *morseToText);
 
 int morse_createMorseToBinaryMapping(BisTree *morseToBinary);
@@ -61,6 +189,93 @@ int morse_createBinaryToMorseMapping(BisTree *binaryToMorse);
 
 
 
+/*
+ * Same as above, with dictionary keys and values taken from the given allocator
+ * bst_destroy() gives them back to it, and must still be called with an arena
+ * Allocator: the tree nodes come from the bst library's malloc(). Only the key
+ * And value releases become no-ops, the arena is reset after bst_destroy()
+ * Arena keys and values carry no allocator header and are packed back to back
+ * (314 bytes of arena for the keys and values of the Morse-To-ASCII mapping)
+*/
+
+int morse_createAsciiToMorseMappingWith(BisTree *textToMorse, const MorseDialect *dialect,
+								const MorseAllocator *allocator);
+
+int morse_createMorseToAsciiMappingWith(BisTree *morseToText, const MorseAllocator *allocator);
+
+int morse_createMorseToBinaryMappingWith(BisTree *morseToBinary, const MorseAllocator *allocator);
+
+int morse_createBinaryToMorseMappingWith(BisTree *binaryToMorse, const MorseAllocator *allocator);
+
+
+
+
+
+/*
+ * Flat dictionary, owned by the library: one array of key / value pairs sorted
+ * By key, followed by all key and value strings, taken from the allocator as ONE
+ * Block and searched by bisection. Built with an arena allocator, the whole
+ * Dictionary lives inside the arena and nothing comes from malloc() or the bst
+ * Library (1181 bytes of arena for Morse-To-ASCII on a 64-bit host)
+ *
+ * The create functions return 0 for successful building, -1 for memory allocation
+ * Failure. morse_destroyDictionary() gives the block back to the allocator
+*/
+
+typedef struct MorseDictionaryEntry_ {
+
+	const char *key;
+	const char *value;
+
+} MorseDictionaryEntry;
+
+typedef struct MorseDictionary_ {
+
+	MorseDictionaryEntry *entries;			/* Sorted by key, strings follow the array */
+	int entryCount;
+	int isCharacterKey;						/* 1 if only the first key character counts */
+	const MorseDialect *dialect;			/* Glyphs and separators of the morse strings */
+	const MorseAllocator *allocator;
+
+} MorseDictionary;
+
+int morse_createAsciiToMorseDictionaryWith(MorseDictionary *textToMorse, const MorseDialect *dialect,
+								const MorseAllocator *allocator);
+
+int morse_createMorseToAsciiDictionaryWith(MorseDictionary *morseToText, const MorseAllocator *allocator);
+
+int morse_createMorseToBinaryDictionaryWith(MorseDictionary *morseToBinary, const MorseAllocator *allocator);
+
+int morse_createBinaryToMorseDictionaryWith(MorseDictionary *binaryToMorse, const MorseAllocator *allocator);
+
+void morse_destroyDictionary(MorseDictionary *dictionary);
+
+
+
+/*
+ * The four conversions over a MorseDictionary instead of a BisTree
+ * Same contracts and byte for byte the same output as morse_convAsciiToMorse()
+ * And the others. ASCII-To-Morse uses the dialect its dictionary was built with
+*/
+
+int morse_convAsciiToMorseDictionary(const MorseDictionary *textToMorse,
+								char *AsciiInputString, int AsciiStringLen,
+								char *morseOutputString, int *morseStringLen);
+
+int morse_convMorseToAsciiDictionary(const MorseDictionary *morseToText,
+								char *morseInputString, int morseStringLen,
+								char *AsciiOutputString, int *AsciiStringLen);
+
+int morse_convMorseToBinaryDictionary(const MorseDictionary *morseToBinary,
+								char *morseInputSequence, int morseSequenceLen,
+								char *binaryOutputSequence, int *binarySequenceLen);
+
+int morse_convBinaryToMorseDictionary(const MorseDictionary *binaryToMorse,
+								char *binaryInputString, int binarySequenceLen,
+								char *morseOutputString, int *morseSequenceLen);
+
+
+
 
 
 
@@ -150,6 +365,18 @@ int morse_convAsciiToMorse (BisTree *checkMap, char *AsciiInputString, int Ascii
 
 
 
+/*
+	Same as morse_convAsciiToMorse(), but writes the letter separator of a dialect
+	The checkMap must be created by morse_createAsciiToMorseMappingEx() with the
+	same dialect, so it already holds the dialect glyphs and word separator
+*/
+
+int morse_convAsciiToMorseEx (BisTree *checkMap, const MorseDialect *dialect,
+								char *AsciiInputString, int AsciiStringLen,
+    							char *morseOutputString, int *morseStringLen);
+
+
+
 
 
 
@@ -181,6 +408,617 @@ int morse_convMorseToAscii (BisTree *checkMap, char *morseInputString, int morse
 
 
 
+/*
+	Same as morse_convMorseToAscii(), but reads the glyphs and separators of a dialect
+	in one single pass. Uses the ordinary morse_createMorseToAsciiMapping() dictionary
+	Every word separator (or word gap) produces one SPACE character in the output
+*/
+
+int morse_convMorseToAsciiEx (BisTree *checkMap, const MorseDialect *dialect,
+								char *morseInputString, int morseStringLen,
+    							char *AsciiOutputString, int *AsciiStringLen);
+
+
+
+
+
+
+
+
+
+
+
+/*
+	Scatter-gather and callback variants of the four conversions
+	They use the same dictionaries and produce the very same bytes as the
+	Ordinary conversion functions, but write them through a list of segments
+	Or a MorseSink instead of one pre-allocated array
+
+	Segment variants fill the segments in order and fail if they are too small
+	Sink variants call sink->write() for each full block and the final partial one
+
+	The length output is the total number of bytes written
+	All of them return 0 for successful conversion, -1 otherwise
+*/
+
+int morse_convAsciiToMorseSegments (BisTree *checkMap, const MorseDialect *dialect,
+								char *AsciiInputString, int AsciiStringLen,
+								MorseSegment *segments, int segmentCount, int *morseStringLen);
+
+int morse_convAsciiToMorseSink (BisTree *checkMap, const MorseDialect *dialect,
+								char *AsciiInputString, int AsciiStringLen,
+								MorseSink *sink, int *morseStringLen);
+
+int morse_convMorseToAsciiSegments (BisTree *checkMap, const MorseDialect *dialect,
+								char *morseInputString, int morseStringLen,
+								MorseSegment *segments, int segmentCount, int *AsciiStringLen);
+
+int morse_convMorseToAsciiSink (BisTree *checkMap, const MorseDialect *dialect,
+								char *morseInputString, int morseStringLen,
+								MorseSink *sink, int *AsciiStringLen);
+
+int morse_convMorseToBinarySegments (BisTree *checkMap, char *morseInputSequence, int morseSequenceLen,
+								MorseSegment *segments, int segmentCount, int *binarySequenceLen);
+
+int morse_convMorseToBinarySink (BisTree *checkMap, char *morseInputSequence, int morseSequenceLen,
+								MorseSink *sink, int *binarySequenceLen);
+
+int morse_convBinaryToMorseSegments (BisTree *checkMap, char *binaryInputString, int binarySequenceLen,
+								MorseSegment *segments, int segmentCount, int *morseSequenceLen);
+
+int morse_convBinaryToMorseSink (BisTree *checkMap, char *binaryInputString, int binarySequenceLen,
+								MorseSink *sink, int *morseSequenceLen);
+
+#endif /* MORSE_FREESTANDING */
+
+
+
+
+
+
+
+
+
+
+/*
+ * Dictionary-free conversions
+ *
+ * Same contracts and byte for byte the same output as the four conversions
+ * Above in the native dialect, but letters come from the const symbol tables
+ * (Dichotomic tree in heap order) instead of a BisTree. No heap, no bst library,
+ * Only the caller's buffers and a few bytes of stack. The tables take 272 bytes
+ * Of read-only data, so they stay in flash on small targets
+*/
+
+int morse_convAsciiToMorseStatic(char *AsciiInputString, int AsciiStringLen,
+								char *morseOutputString, int *morseStringLen);
+
+int morse_convMorseToAsciiStatic(char *morseInputString, int morseStringLen,
+								char *AsciiOutputString, int *AsciiStringLen);
+
+int morse_convMorseToBinaryStatic(char *morseInputSequence, int morseSequenceLen,
+								char *binaryOutputSequence, int *binarySequenceLen);
+
+int morse_convBinaryToMorseStatic(char *binaryInputString, int binarySequenceLen,
+								char *morseOutputString, int *morseSequenceLen);
+
+
+
+
+
+
+
+
+
+
+/*
+ * Multi-channel Binary-to-Morse decoder
+ *
+ * Decodes many independent binary bit streams at once, one step of every channel
+ * per input frame. All per-channel decoder state is kept in a structure-of-arrays
+ * layout (one byte array per field), so a single step is a straight loop over
+ * contiguous bytes without branches. GCC vectorizes it with 16 byte (SSE2, NEON)
+ * or 32 byte (AVX2) vectors when built with -O3, or -O2 -ftree-vectorize.
+ * 32 bit x86 builds also need -msse2
+ * No dictionary is needed, a segment is decoded by the count of its leading '1'
+ *
+ * Decoded morse characters go to a ring buffer per channel and are pulled out
+ * with morse_readChannel(). Decoding and reading must happen on the same thread
+*/
+
+#define MORSE_CHANNEL_OK 0
+#define MORSE_CHANNEL_INVALID 1			/* Invalid binary segment seen, channel halted */
+#define MORSE_CHANNEL_OVERFLOW 2		/* Ring buffer was full, characters dropped */
+
+typedef struct MorseChannelBank_ {
+
+	int channelCount;
+	unsigned int ringMask;				/* Ring capacity - 1, capacity is power of 2 */
+
+	unsigned char *onesCount;			/* '1' bits seen in the open segment */
+	unsigned char *channelStatus;		/* MORSE_CHANNEL_* flags */
+	unsigned char *emitFlag;			/* Scratch: channel closed a segment this step */
+	unsigned char *emitSymbol;			/* Scratch: segment index closed this step */
+	char *gatherFrame;					/* Scratch: one frame gathered from blocks */
+
+	unsigned int *ringHead;
+	unsigned int *ringTail;
+	char *ringMemory;					/* channelCount rings, back to back */
+
+	const MorseAllocator *allocator;
+
+} MorseChannelBank;
+
+
+
+/*
+	Creates a bank of channelCount decoders, each with a ring buffer holding
+	at least ringCapacity morse characters (rounded up to a power of 2)
+
+	Returns 0 for successful creation, -1 for memory allocation failure
+	One must call morse_destroyChannelBank() after being done with the bank
+*/
+
+#ifndef MORSE_FREESTANDING
+int morse_createChannelBank(MorseChannelBank *bank, int channelCount, int ringCapacity);
+#endif
+
+int morse_createChannelBankWith(MorseChannelBank *bank, int channelCount, int ringCapacity,
+								const MorseAllocator *allocator);
+
+void morse_destroyChannelBank(MorseChannelBank *bank);
+
+void morse_resetChannel(MorseChannelBank *bank, int channel);
+
+int morse_getChannelStatus(MorseChannelBank *bank, int channel);
+
+
+
+/*
+	Advance all channels of the bank in lockstep
+
+	morse_decodeChannelsInterleaved():
+		char *binaryFrames			- frameCount frames, each holding one binary
+									  character ('0' or '1') of every channel in order
+		int frameCount				- Number of frames
+	morse_decodeChannelBlocks():
+		char **binaryBlocks			- One pointer per channel to its next binary block
+		int blockLen				- Number of binary characters in every block
+
+	Returns 0 if every channel is fine, -1 if any channel is now invalid or overflowed
+	(Check each channel with morse_getChannelStatus)
+*/
+
+int morse_decodeChannelsInterleaved(MorseChannelBank *bank, char *binaryFrames, int frameCount);
+
+int morse_decodeChannelBlocks(MorseChannelBank *bank, char **binaryBlocks, int blockLen);
+
+
+
+/*
+	Pull decoded morse characters of one channel out of its ring buffer
+
+	out:
+		char *morseOutputString		- Space for at most maxLen morse characters
+		int *morseStringLen			- Number of morse characters copied
+
+	Returns 0 for success, -1 for an invalid channel
+*/
+
+int morse_readChannel(MorseChannelBank *bank, int channel,
+								char *morseOutputString, int maxLen, int *morseStringLen);
+
+
+
+
+
+
+
+
+
+
+
+/*
+ * Keying schedule generator, for hardware keyers and transmitters
+ *
+ * Converts ASCII text straight into run-length on/off timing, without building
+ * A morse string first. Durations are in dot units (dot 1, dash 3, gap inside a
+ * Letter 1, letter gap 3, word gap 7) or in microseconds at a given speed
+ *
+ * A MorseKeyer holds the element durations and a precomputed timing template of
+ * Every ASCII character, build it once with morse_initKeyer() and reuse it
+*/
+
+typedef struct MorseKeyer_ {
+
+	long dotTime;
+	long dashTime;
+	long elementGap;					/* Gap between elements of one letter */
+	long letterGap;
+	long wordGap;
+	long charTime[128];					/* Duration of each letter alone, -1 if none */
+
+} MorseKeyer;
+
+
+
+/*
+	Initialize a keyer for a speed
+	in:
+		int wpm						- Character speed in words per minute (PARIS)
+									  0 gives durations in dot units instead of microseconds
+		int farnsworthWpm			- Overall Farnsworth speed, below wpm stretches the
+									  letter and word gaps. 0 disables Farnsworth timing
+
+	Returns 0 for success, -1 for invalid speeds
+*/
+
+int morse_initKeyer(MorseKeyer *keyer, int wpm, int farnsworthWpm);
+
+
+
+/*
+	Convert ASCII text to a run-length keying schedule
+	Positive entries are key-down durations, negative entries are key-up durations
+	They always alternate, neighbouring gaps are merged into one key-up entry
+
+	out:
+		long *keyingOutput			- Pre-allocated space, at most 12 entries per input character
+		int *keyingLen				- Number of entries written
+
+	Returns 0 for successful conversion, -1 for a character without morse code
+	Or for a run of SPACE characters whose key-up time does not fit a long
+*/
+
+int morse_convAsciiToKeying(MorseKeyer *keyer, char *AsciiInputString, int AsciiStringLen,
+								long *keyingOutput, int *keyingLen);
+
+
+
+/*
+	Total airtime of ASCII text, equal to the sum of the keying schedule durations
+	Uses only the per character templates, nothing is materialized
+	The total is a double: a 32 bit long overflows after 35.8 minutes of microseconds,
+	A double counts them exactly up to 2^53 (285 years)
+
+	Returns 0 for success, -1 for a character without morse code
+*/
+
+int morse_getKeyingAirtime(MorseKeyer *keyer, char *AsciiInputString, int AsciiStringLen,
+								double *airtime);
+
+
+
+
+
+
+
+
+
+
+
+/*
+ * Framed binary stream, for binary text sent over a lossy link
+ *
+ * The binary text is cut at segment boundaries into frames, each with a SYNC
+ * Marker, a 16 bit sequence number, the payload length and a CRC-32. After a
+ * Damaged frame the decoder simply scans on to the next SYNC, and it reports
+ * Which input and which sequence numbers were lost, so that only the damaged
+ * Frames have to be sent again (with morse_encodeBinaryFrame and their sequence)
+*/
+
+#define MORSE_FRAME_MAX_PAYLOAD 4096			/* Binary characters in one frame */
+#define MORSE_FRAME_MAX_OVERHEAD 91				/* Framing characters added per frame */
+
+#define MORSE_FRAME_GOOD 0
+#define MORSE_FRAME_LOST 1
+
+typedef struct MorseFrameEvent_ {
+
+	int type;							/* MORSE_FRAME_GOOD or MORSE_FRAME_LOST */
+	unsigned int sequence;				/* GOOD: its sequence, LOST: first missing sequence */
+	unsigned int frameCount;			/* LOST: missing sequences, 0 if unknown (stream end) */
+	long streamOffset;					/* Position in the whole framed stream */
+	long length;						/* GOOD: payload length, LOST: discarded characters */
+	const char *payload;				/* GOOD: payload, points into the decoded input */
+
+} MorseFrameEvent;
+
+typedef struct MorseFrameDecoder_ {
+
+	unsigned int nextSequence;
+	long streamPosition;				/* Framed characters consumed so far */
+	long lostStart;						/* Stream position right after the last good frame */
+	unsigned long goodFrames;
+	unsigned long badFrames;
+
+} MorseFrameDecoder;
+
+
+
+/*
+	Encode one frame, or a whole binary text as consecutive frames
+
+	in:
+		char *binaryPayload			- Whole binary segments (as morse_convMorseToBinary writes)
+		int maxPayloadLen			- Longest payload of one frame, at least 4
+		unsigned int sequence		- Sequence number of the (first) frame, counted modulo 65536
+	out:
+		char *framedOutput			- Pre-allocated space, payload length plus
+									  MORSE_FRAME_MAX_OVERHEAD for every frame
+		int *framedLen				- Number of characters written
+		int *frameCount				- Number of frames written
+
+	Returns 0 for success, -1 for invalid or unfinished binary segments
+*/
+
+int morse_encodeBinaryFrame(unsigned int sequence, char *binaryPayload, int payloadLen,
+								char *framedOutput, int *framedLen);
+
+int morse_encodeBinaryFrames(char *binaryInputString, int binarySequenceLen, int maxPayloadLen,
+								unsigned int firstSequence, char *framedOutput, int *framedLen,
+								int *frameCount);
+
+
+
+/*
+	Decode framed binary text, input may be split anywhere between calls
+
+	in:
+		int isLastInput				- 1 if no more input will follow
+		int maxEvents				- Room for events, at least 2
+	out:
+		MorseFrameEvent *events		- Good frames and lost ranges, in stream order
+		int *eventCount				- Number of events written
+		int *consumed				- Input characters used up, the caller must offer
+									  the rest again, in front of its next input
+
+	Returns 0 for success, -1 if maxEvents is less than 2
+	Payloads of good frames are ready for morse_convBinaryToMorse()
+*/
+
+void morse_initFrameDecoder(MorseFrameDecoder *decoder, unsigned int firstSequence);
+
+int morse_decodeBinaryFrames(MorseFrameDecoder *decoder, char *framedInput, int framedLen,
+								int isLastInput, MorseFrameEvent *events, int maxEvents,
+								int *eventCount, int *consumed);
+
+
+
+
+
+
+
+
+
+
+
+#ifndef MORSE_FREESTANDING
+
+/*
+ * Bulk ASCII-To-Morse encoder, for large amounts of text
+ *
+ * Holds every morse letter in a fixed width, padded table entry, followed by the
+ * Letter separator. The input is classified 16 characters at a time (with SSE2
+ * Where available), and each letter is written with one fixed size store
+ * The output is byte for byte the same as morse_convAsciiToMorseEx() writes
+*/
+
+#define MORSE_BULK_ENTRY 32
+
+typedef struct MorseBulkEncoder_ {
+
+	char code[128][MORSE_BULK_ENTRY];		/* Letter, then letter separator, then padding */
+	unsigned char length[128];				/* Length of the letter alone, 0 if none */
+	unsigned char separatorLen;
+	unsigned char isNarrow;					/* All entries fit in half of MORSE_BULK_ENTRY */
+
+} MorseBulkEncoder;
+
+
+
+/*
+	Fill the encoder tables from a dictionary of morse_createAsciiToMorseMapping()
+	or morse_createAsciiToMorseMappingEx() and the same dialect. The dictionary
+	is not needed afterwards
+
+	Returns 0 for success, -1 if a letter and separator are wider than MORSE_BULK_ENTRY
+*/
+
+int morse_initBulkEncoder(MorseBulkEncoder *encoder, BisTree *checkMap, const MorseDialect *dialect);
+
+
+
+/*
+	Convert ASCII text to morse code, same contract as morse_convAsciiToMorse()
+	Returns 0 for successful conversion, -1 for a character without morse code
+*/
+
+int morse_convAsciiToMorseBulk(const MorseBulkEncoder *encoder,
+								char *AsciiInputString, int AsciiStringLen,
+								char *morseOutputString, int *morseStringLen);
+
+#endif /* MORSE_FREESTANDING */
+
+
+
+
+
+
+
+
+
+
+
+/*
+ * Compact symbol arrays, one unsigned short per letter
+ *
+ * A symbol is packed like the dichotomic tree index: (1 << length) | dashBits,
+ * Dash bits read most significant first below the leading sentinel bit. So
+ * ".-" (A) is 0x0005 and "-..." (B) is 0x0018. Letters of up to 15 elements fit,
+ * Including prosigns without an ASCII character
+ *
+ * The n-th letter is simply symbols[n], and every letter takes 2 bytes
+ * Instead of up to 7 morse characters or 25 binary characters
+*/
+
+#define MORSE_SYMBOL_INVALID 0x0000
+#define MORSE_SYMBOL_WORD_GAP 0x0001
+#define MORSE_SYMBOL_MAX_ELEMENTS 15
+
+
+
+/*
+	Converters between symbol arrays and the three text formats
+	Morse and Binary text are the native formats of morse_convMorseToAscii()
+	and morse_convBinaryToMorse(), symbols are written back the same way as
+	morse_convAsciiToMorse() and morse_convMorseToBinary() write them
+
+	out:
+		unsigned short *symbolOutput	- Pre-allocated space, one symbol per ASCII character,
+										  at most one per morse / binary character
+		int *symbolCount				- Number of symbols written
+		char *...OutputString			- Pre-allocated space for the text, without NUL (\0)
+
+	Return 0 for successful conversion, -1 for invalid input or symbols
+	(morse_convSymbolsToAscii() also fails for letters without ASCII character)
+*/
+
+int morse_convAsciiToSymbols(char *AsciiInputString, int AsciiStringLen,
+								unsigned short *symbolOutput, int *symbolCount);
+
+int morse_convSymbolsToAscii(unsigned short *symbolInput, int symbolCount,
+								char *AsciiOutputString, int *AsciiStringLen);
+
+int morse_convMorseToSymbols(char *morseInputString, int morseStringLen,
+								unsigned short *symbolOutput, int *symbolCount);
+
+int morse_convSymbolsToMorse(unsigned short *symbolInput, int symbolCount,
+								char *morseOutputString, int *morseStringLen);
+
+int morse_convBinaryToSymbols(char *binaryInputString, int binarySequenceLen,
+								unsigned short *symbolOutput, int *symbolCount);
+
+int morse_convSymbolsToBinary(unsigned short *symbolInput, int symbolCount,
+								char *binaryOutputString, int *binaryStringLen);
+
+
+
+
+
+
+
+
+
+
+
+/*
+ * Incremental decoder for live keying, one dot or dash at a time
+ *
+ * The whole decoder state is one byte, the node of the dichotomic morse tree
+ * (Heap order: DOT goes from node n to 2n, DASH to 2n + 1). Every step is a
+ * Shift and two lookups into constant tables, so it suits microcontrollers too
+ * Keep one state byte per channel, start it with morse_initTreeDecoder()
+*/
+
+#define MORSE_TREE_OFF 0			/* Path fell off the tree, waiting for the next gap */
+#define MORSE_TREE_ROOT 1			/* No element of the letter seen yet */
+
+void morse_initTreeDecoder(unsigned char *decoderState);
+
+
+
+/*
+	Feed one native morse character ('.', '-', '/' or '|')
+
+	out:
+		char *asciiOutput			- Space for 2 characters, a letter gap writes the
+									  letter, a word gap writes the letter and a SPACE
+
+	Returns the number of characters written (0, 1 or 2)
+	Returns -1 at once when a DOT or DASH leaves the tree (no such letter), when a
+	Gap closes a node without letter, or for any other character. After a -1 the
+	Decoder skips to the next gap by itself
+
+	Feed a letter separator at the end of input to get the last letter
+*/
+
+int morse_stepTreeDecoder(unsigned char *decoderState, char morseChar, char *asciiOutput);
+
+
+
+
+
+
+
+
+
+
+
+#ifndef MORSE_FREESTANDING
+
+/*
+ * Large buffers
+ *
+ * The conversions above take and give int lengths, so they stop at 2 GB
+ * The functions below take and give size_t lengths for a single pass over very
+ * Large (eg. memory mapped) data. All lengths are accumulated with overflow
+ * Checks. The int interfaces run the same code, and fail (-1) if their output
+ * Length does not fit into an int
+*/
+
+
+
+/*
+	size_t variants of morse_convAsciiToMorse(), morse_convMorseToAscii(),
+	morse_convMorseToBinary() and morse_convBinaryToMorse(), same contracts
+
+	Returns 0 for successful conversion, -1 otherwise
+*/
+
+int morse_convAsciiToMorseZ (BisTree *checkMap, char *AsciiInputString, size_t AsciiStringLen,
+								char *morseOutputString, size_t *morseStringLen);
+
+int morse_convMorseToAsciiZ (BisTree *checkMap, char *morseInputString, size_t morseStringLen,
+								char *AsciiOutputString, size_t *AsciiStringLen);
+
+int morse_convMorseToBinaryZ (BisTree *checkMap, char *morseInputSequence, size_t morseSequenceLen,
+								char *binaryOutputSequence, size_t *binarySequenceLen);
+
+int morse_convBinaryToMorseZ (BisTree *checkMap, char *binaryInputString, size_t binarySequenceLen,
+								char *morseOutputString, size_t *morseSequenceLen);
+
+
+
+/*
+	Exact output length of a conversion, without writing any output
+	Takes the same dictionary as the conversion itself
+
+	in:
+		BisTree *checkMap			- Dictionary of the conversion
+		char *...InputString		- Input to measure
+		size_t ...Len				- Length of the input
+	out:
+		size_t *...Len				- Length the output of the conversion will have
+
+	Returns 0 for a convertible input, -1 otherwise or if the length overflows
+*/
+
+int morse_getAsciiToMorseLengthZ (BisTree *checkMap, char *AsciiInputString, size_t AsciiStringLen,
+								size_t *morseStringLen);
+
+int morse_getMorseToAsciiLengthZ (BisTree *checkMap, char *morseInputString, size_t morseStringLen,
+								size_t *AsciiStringLen);
+
+int morse_getMorseToBinaryLengthZ (BisTree *checkMap, char *morseInputSequence, size_t morseSequenceLen,
+								size_t *binarySequenceLen);
+
+int morse_getBinaryToMorseLengthZ (BisTree *checkMap, char *binaryInputString, size_t binarySequenceLen,
+								size_t *morseSequenceLen);
+
+#endif /* MORSE_FREESTANDING */
+
+
 
 
 
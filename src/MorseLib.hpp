@@ -0,0 +1,439 @@
+
+
+/************************************************************************************
+	Header-only C++ Interface of Morse Library Conversions
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef MORSELIB_HPP
+#define MORSELIB_HPP
+
+
+
+
+
+
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if __cplusplus >= 202002L
+#include <span>
+#define MORSE_CONSTEVAL consteval
+#else
+#define MORSE_CONSTEVAL constexpr
+#endif
+
+
+
+/*
+ * This header mirrors the four conversions of "MorseLib.h" for C++17/20 callers
+ * It does not need libbst, libstq or the compiled libmorse.a at all
+ *
+ * Every lookup table is generated at compile time from the very same symbol set
+ * That morse_buildMorseAsciiObjectList() loads into the BisTree dictionaries,
+ * So the output of both interfaces is byte-identical
+ *
+ * Output is pushed into a Sink, which is any callable object of the form
+ *		void sink(const char *data, std::size_t length)
+ * So callers can append into their own containers without intermediate copies
+ *
+ * All conversion functions return true for successful conversion, false otherwise
+*/
+
+namespace morse {
+
+
+inline constexpr char dot = '.';
+inline constexpr char dash = '-';
+inline constexpr char letter_separator = '/';
+inline constexpr char word_separator = '|';
+
+inline constexpr std::string_view binary_dot = "0";
+inline constexpr std::string_view binary_dash = "10";
+inline constexpr std::string_view binary_letter_separator = "110";
+inline constexpr std::string_view binary_word_separator = "1110";
+
+
+
+
+namespace detail {
+
+
+	struct symbol {
+		char ascii;
+		std::string_view code;
+	};
+
+
+	/* Same order and content as morseCodes[] / asciiChars[] of the C library */
+	inline constexpr symbol symbols[] = {
+		/*		From capital A to Z		*/
+		{ 'A', ".-" }, { 'B', "-..." }, { 'C', "-.-." }, { 'D', "-.." }, { 'E', "." },
+		{ 'F', "..-." }, { 'G', "--." }, { 'H', "...." }, { 'I', ".." }, { 'J', ".---" },
+		{ 'K', "-.-" }, { 'L', ".-.." }, { 'M', "--" }, { 'N', "-." }, { 'O', "---" },
+		{ 'P', ".--." }, { 'Q', "--.-" }, { 'R', ".-." }, { 'S', "..." }, { 'T', "-" },
+		{ 'U', "..-" }, { 'V', "...-" }, { 'W', ".--" }, { 'X', "-..-" }, { 'Y', "-.--" },
+		{ 'Z', "--.." },
+		/*		From 0 to 9	(numeric characters)	*/
+		{ '0', ".----" }, { '1', "..---" }, { '2', "...--" }, { '3', "....-" },
+		{ '4', "....." }, { '5', "-...." }, { '6', "--..." }, { '7', "---.." },
+		{ '8', "----." }, { '9', "-----" },
+		/*		Special characters								*/
+		/*		In order: <space> + - * / = ( ) ? ! . ' " , ;	*/
+		{ ' ', "|" },
+		{ '+', ".-.-." }, { '-', "-....-" }, { '*', "-.-.-" }, { '/', "-..-." },
+		{ '=', "-...-" }, { '(', "-.--." }, { ')', "-.--.-" }, { '?', "..--.." },
+		{ '!', "..--.-" }, { '.', ".-.-.-" }, { '\'', ".----." }, { '"', ".-..-." },
+		{ ',', "--..--" }, { ';', "---..." }
+	};
+
+	inline constexpr std::size_t max_code_length = 6;
+
+
+	struct code_entry {
+		char code[max_code_length];
+		unsigned char length;			/* 0 means the character has no Morse code */
+	};
+
+
+	/* Indexed by (unsigned char) ASCII value */
+	constexpr std::array<code_entry, 256> make_encode_table() {
+
+		std::array<code_entry, 256> table{};
+
+		for (const symbol &s : symbols) {
+			code_entry &e = table[static_cast<unsigned char>(s.ascii)];
+			for (std::size_t i = 0; i < s.code.size(); ++i)
+				e.code[i] = s.code[i];
+			e.length = static_cast<unsigned char>(s.code.size());
+		}
+		return table;
+	}
+
+
+	/* Dichotomic tree in heap order: index is (1 << length) | dash bits, MSB first */
+	constexpr std::array<char, 2 << max_code_length> make_decode_table() {
+
+		std::array<char, 2 << max_code_length> table{};
+
+		for (const symbol &s : symbols) {
+			if (s.code[0] != dot && s.code[0] != dash) continue;
+			unsigned int node = 1;
+			for (char c : s.code)
+				node = (node << 1) | (c == dash ? 1u : 0u);
+			table[node] = s.ascii;
+		}
+		return table;
+	}
+
+	inline constexpr std::array<code_entry, 256> encode_table = make_encode_table();
+	inline constexpr std::array<char, 2 << max_code_length> decode_table = make_decode_table();
+
+
+	constexpr bool is_word_boundary(std::string_view in, std::size_t i) {
+		return i + 1 == in.size() || in[i] == ' ' || in[i + 1] == ' ';
+	}
+
+} /* namespace detail */
+
+
+
+
+/*
+	Ready made sinks
+	append_to()		- appends to a std::string (or anything with append(ptr, len))
+	buffer_sink		- writes into a caller owned fixed buffer, remembers overflow
+*/
+
+template <class Container>
+constexpr auto append_to(Container &out) {
+	return [&out](const char *data, std::size_t length) { out.append(data, length); };
+}
+
+
+class buffer_sink {
+
+public:
+	constexpr buffer_sink(char *buffer, std::size_t capacity) noexcept
+		: buffer_(buffer), capacity_(capacity), length_(0), overflow_(false) {}
+
+#if __cplusplus >= 202002L
+	constexpr explicit buffer_sink(std::span<char> buffer) noexcept
+		: buffer_sink(buffer.data(), buffer.size()) {}
+#endif
+
+	constexpr void operator()(const char *data, std::size_t length) noexcept {
+		if (length > capacity_ - length_) {
+			overflow_ = true;
+			length = capacity_ - length_;
+		}
+		for (std::size_t i = 0; i < length; ++i)
+			buffer_[length_ + i] = data[i];
+		length_ += length;
+	}
+
+	constexpr std::size_t size() const noexcept { return length_; }
+	constexpr bool overflow() const noexcept { return overflow_; }
+	constexpr std::string_view view() const noexcept { return { buffer_, length_ }; }
+
+private:
+	char *buffer_;
+	std::size_t capacity_;
+	std::size_t length_;
+	bool overflow_;
+};
+
+
+
+
+/*
+	Length queries, they return the exact output length of the matching conversion
+	Or std::string_view::npos if the input can not be converted
+*/
+
+constexpr std::size_t ascii_to_morse_length(std::string_view ascii) noexcept {
+
+	std::size_t length = 0;
+
+	for (std::size_t i = 0; i < ascii.size(); ++i) {
+		const detail::code_entry &e = detail::encode_table[static_cast<unsigned char>(ascii[i])];
+		if (e.length == 0) return std::string_view::npos;
+		length += e.length + (detail::is_word_boundary(ascii, i) ? 0 : 1);
+	}
+	return length;
+}
+
+
+constexpr std::size_t morse_to_binary_length(std::string_view morse) noexcept {
+
+	std::size_t length = 0;
+
+	for (char c : morse) {
+		switch (c) {
+			case dot:				length += binary_dot.size(); break;
+			case dash:				length += binary_dash.size(); break;
+			case letter_separator:	length += binary_letter_separator.size(); break;
+			case word_separator:	length += binary_word_separator.size(); break;
+			default:				return std::string_view::npos;
+		}
+	}
+	return length;
+}
+
+
+
+
+/*
+	Convert ASCII text to morse code, same rules as morse_convAsciiToMorse()
+	A letter separator is written between two letters, but never around a space
+*/
+
+template <class Sink>
+constexpr bool ascii_to_morse(std::string_view ascii, Sink &&sink) {
+
+	const char separator = letter_separator;
+
+	for (std::size_t i = 0; i < ascii.size(); ++i) {
+		const detail::code_entry &e = detail::encode_table[static_cast<unsigned char>(ascii[i])];
+		if (e.length == 0) return false;
+		sink(e.code, e.length);
+		if (!detail::is_word_boundary(ascii, i))
+			sink(&separator, 1);
+	}
+	return true;
+}
+
+
+
+
+/*
+	Convert morse code to ASCII text, same rules as morse_convMorseToAscii()
+	Each word separator produces one space, conversion stops at an empty letter
+*/
+
+template <class Sink>
+constexpr bool morse_to_ascii(std::string_view morse, Sink &&sink) {
+
+	const char space = ' ';
+	std::size_t i = 0;
+
+	while (i < morse.size()) {
+
+		while (i < morse.size() && morse[i] == word_separator) {
+			sink(&space, 1);
+			++i;
+		}
+		if (i < morse.size() && morse[i] == letter_separator) ++i;
+
+		unsigned int node = 1;
+		std::size_t begin = i;
+		while (i < morse.size() && morse[i] != letter_separator && morse[i] != word_separator) {
+			if (i - begin == detail::max_code_length) return false;
+			if (morse[i] == dot)		node = node << 1;
+			else if (morse[i] == dash)	node = (node << 1) | 1u;
+			else						return false;
+			++i;
+		}
+		if (i == begin) break;
+
+		const char letter = detail::decode_table[node];
+		if (letter == '\0') return false;
+		sink(&letter, 1);
+	}
+	return true;
+}
+
+
+
+
+/* Convert morse code to binary bit string, same rules as morse_convMorseToBinary() */
+
+template <class Sink>
+constexpr bool morse_to_binary(std::string_view morse, Sink &&sink) {
+
+	for (char c : morse) {
+		std::string_view bits;
+		switch (c) {
+			case dot:				bits = binary_dot; break;
+			case dash:				bits = binary_dash; break;
+			case letter_separator:	bits = binary_letter_separator; break;
+			case word_separator:	bits = binary_word_separator; break;
+			default:				return false;
+		}
+		sink(bits.data(), bits.size());
+	}
+	return true;
+}
+
+
+
+
+/*
+	Convert binary bit string to morse code, same rules as morse_convBinaryToMorse()
+	Every '0' closes a segment, the count of preceding '1' selects the morse character
+*/
+
+template <class Sink>
+constexpr bool binary_to_morse(std::string_view binary, Sink &&sink) {
+
+	constexpr char segment[4] = { dot, dash, letter_separator, word_separator };
+	unsigned int ones = 0;
+
+	for (char c : binary) {
+		if (c == '0') {
+			sink(segment + ones, 1);
+			ones = 0;
+		} else if (c == '1' && ones < 3) {
+			++ones;
+		} else {
+			return false;
+		}
+	}
+	return ones == 0;
+}
+
+
+
+
+/* Convenience overloads returning std::string, they throw std::invalid_argument */
+
+inline std::string ascii_to_morse(std::string_view ascii) {
+
+	std::string out;
+	std::size_t length = ascii_to_morse_length(ascii);
+
+	if (length == std::string_view::npos)
+		throw std::invalid_argument("morse: character has no morse code");
+	out.reserve(length);
+	ascii_to_morse(ascii, append_to(out));
+	return out;
+}
+
+inline std::string morse_to_ascii(std::string_view morse) {
+
+	std::string out;
+
+	out.reserve(morse.size() / 2 + 1);
+	if (!morse_to_ascii(morse, append_to(out)))
+		throw std::invalid_argument("morse: invalid morse sequence");
+	return out;
+}
+
+inline std::string morse_to_binary(std::string_view morse) {
+
+	std::string out;
+	std::size_t length = morse_to_binary_length(morse);
+
+	if (length == std::string_view::npos)
+		throw std::invalid_argument("morse: invalid morse character");
+	out.reserve(length);
+	morse_to_binary(morse, append_to(out));
+	return out;
+}
+
+inline std::string binary_to_morse(std::string_view binary) {
+
+	std::string out;
+
+	out.reserve(binary.size());
+	if (!binary_to_morse(binary, append_to(out)))
+		throw std::invalid_argument("morse: invalid binary segment");
+	return out;
+}
+
+
+
+
+/*
+	Compile time encoding of string literals, for fixed beacons and call signs
+	The result lives in static storage and costs nothing at runtime:
+
+		constexpr auto cq = morse::encode_literal("CQ CQ DE");
+		transmit(cq.data(), cq.size());
+
+	An unknown character is a compile error (consteval with C++20)
+*/
+
+template <std::size_t Capacity>
+struct fixed_string {
+
+	char buffer[Capacity == 0 ? 1 : Capacity] {};
+	std::size_t length = 0;
+
+	constexpr const char *data() const noexcept { return buffer; }
+	constexpr std::size_t size() const noexcept { return length; }
+	constexpr std::string_view view() const noexcept { return { buffer, length }; }
+	constexpr operator std::string_view() const noexcept { return view(); }
+};
+
+
+template <std::size_t N>
+MORSE_CONSTEVAL auto encode_literal(const char (&text)[N]) {
+
+	/* Worst case per character: longest code plus one letter separator */
+	fixed_string<(N - 1) * (detail::max_code_length + 1)> out;
+	buffer_sink sink(out.buffer, sizeof(out.buffer));
+
+	if (!ascii_to_morse(std::string_view(text, N - 1), sink))
+		throw std::invalid_argument("morse: character has no morse code");
+	out.length = sink.size();
+	return out;
+}
+
+
+} /* namespace morse */
+
+
+
+#endif
@@ -0,0 +1,268 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Allocators and Arena
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef MORSE_FREESTANDING
+#include <stdlib.h>
+#endif
+#include "MorseLib.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+/*
+ *
+ * Function to allocate a dictionary object (key or value) through an allocator
+ * The allocator is remembered in a small header in front of the object, so the
+ * Single argument destructor of BisTree can give it back to the same allocator
+ * Arena objects are never given back one by one, they get no header at all
+ * And, being characters, no padding either
+ *
+ * Returns address of the object, 0 for memory allocation failure
+ *
+*/
+void *morse_allocateObject(const MorseAllocator *allocator, size_t objectSize);
+
+
+
+/*
+ *
+ * Function to release an object of morse_allocateObject(), used as BisTree destructor
+ *
+*/
+void morse_releaseObject(void *object);
+
+
+
+/*
+ *
+ * BisTree destructor for objects of an arena allocator, does nothing
+ *
+*/
+void morse_keepObject(void *object);
+
+
+
+/*
+ *
+ * Function to test whether an allocator comes from morse_getArenaAllocator()
+ * Returns 1 if it does, 0 otherwise
+ *
+*/
+int morse_isArenaAllocator(const MorseAllocator *allocator);
+
+
+
+/*
+ * Header in front of every dictionary object (except arena ones), the union keeps the object
+ * Behind it aligned for any type
+*/
+typedef union MorseObjectHeader_ {
+
+	const MorseAllocator *allocator;
+	void *pointer;
+	double real;
+	long integer;
+
+} MorseObjectHeader;
+
+
+
+#ifndef MORSE_FREESTANDING
+static void *morse_heapAllocate(void *userData, size_t size);
+
+static void morse_heapRelease(void *userData, void *memory);
+#endif
+
+static void *morse_arenaAllocate(void *userData, size_t size);
+
+static void morse_arenaRelease(void *userData, void *memory);
+
+static void *morse_takeArena(MorseArena *arena, size_t size, size_t alignment);
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+#ifndef MORSE_FREESTANDING
+
+/* malloc() and free() of the C library, used wherever no allocator is given */
+const MorseAllocator morse_defaultAllocator = { morse_heapAllocate, morse_heapRelease, 0 };
+
+
+
+
+static void *morse_heapAllocate(void *userData, size_t size) {
+
+	(void) userData;
+	return malloc(size);
+}
+
+
+static void morse_heapRelease(void *userData, void *memory) {
+
+	(void) userData;
+	free(memory);
+}
+
+#endif /* MORSE_FREESTANDING */
+
+
+
+
+void *morse_allocateObject(const MorseAllocator *allocator, size_t objectSize) {
+
+	MorseObjectHeader *header;
+
+	/* No destructor needs to find the arena, so its objects are packed bare */
+	if (morse_isArenaAllocator(allocator) == 1)
+		return morse_takeArena((MorseArena*) allocator->userData, objectSize, sizeof(char));
+
+	header = (MorseObjectHeader*)
+				allocator->allocate(allocator->userData, sizeof(MorseObjectHeader) + objectSize);
+	if (header == 0) return 0;
+
+	header->allocator = allocator;
+	return (void*) (header + 1);
+}
+
+
+
+
+void morse_releaseObject(void *object) {
+
+	MorseObjectHeader *header;
+
+	if (object == 0) return;
+
+	header = ((MorseObjectHeader*) object) - 1;
+	header->allocator->release(header->allocator->userData, (void*) header);
+}
+
+
+
+
+void morse_keepObject(void *object) {
+
+	/* morse_resetArena() gives the object back together with everything else */
+	(void) object;
+}
+
+
+
+
+int morse_isArenaAllocator(const MorseAllocator *allocator) {
+
+	return allocator->allocate == morse_arenaAllocate ? 1 : 0;
+}
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL ARENA FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+void morse_initArena(MorseArena *arena, void *memory, size_t capacity) {
+
+	arena->memory = (char*) memory;
+	arena->capacity = capacity;
+	arena->used = 0;
+}
+
+
+
+
+void morse_resetArena(MorseArena *arena) {
+
+	arena->used = 0;
+}
+
+
+
+
+void morse_getArenaAllocator(MorseArena *arena, MorseAllocator *allocator) {
+
+	allocator->allocate = morse_arenaAllocate;
+	allocator->release = morse_arenaRelease;
+	allocator->userData = (void*) arena;
+}
+
+
+
+
+static void *morse_arenaAllocate(void *userData, size_t size) {
+
+	/* The allocator does not know the type, so every block is suitable for any */
+	return morse_takeArena((MorseArena*) userData, size, sizeof(MorseObjectHeader));
+}
+
+
+
+
+static void *morse_takeArena(MorseArena *arena, size_t size, size_t alignment) {
+
+	size_t alignedOffset;
+
+	/* Bump the offset up to the next boundary of the given alignment */
+	alignedOffset = (arena->used + alignment - 1) / alignment * alignment;
+
+	if (alignedOffset > arena->capacity || size > arena->capacity - alignedOffset) return 0;
+
+	arena->used = alignedOffset + size;
+	return (void*) (arena->memory + alignedOffset);
+}
+
+
+
+
+static void morse_arenaRelease(void *userData, void *memory) {
+
+	/* Single objects are never given back, morse_resetArena() releases them all */
+	(void) userData;
+	(void) memory;
+}
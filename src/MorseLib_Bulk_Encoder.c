@@ -0,0 +1,218 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Bulk ASCII-To-Morse Encoder
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <string.h>
+#include "MorseLib.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+
+
+/*
+ * The bulk encoder works on blocks of 16 ASCII characters
+ *
+ * First the whole block is classified at once: which characters are SPACE,
+ * And whether any character is outside of 7 bit ASCII. From the SPACE mask
+ * The letter separator decision of every character is a plain bit operation
+ *
+ * Then every character stores its whole padded table entry (morse letter
+ * Followed by the letter separator) with one fixed size copy, and the output
+ * Position moves on by the real length only, so the next store overwrites the
+ * Padding. No lookups in the BisTree and no separator branches are left
+*/
+
+#define MORSE_BULK_BLOCK 16
+
+
+
+
+/*
+ * Internal (Static) function to classify one block of 16 characters
+ * Bit i of *spaceMask is set if character i is a SPACE
+ * Returns 0 if all characters are 7 bit ASCII, -1 otherwise
+*/
+static int morse_classifyBulkBlock(const char *block, unsigned int *spaceMask);
+
+
+
+
+
+
+
+
+
+
+
+static int morse_classifyBulkBlock(const char *block, unsigned int *spaceMask) {
+
+#ifdef __SSE2__
+
+	__m128i characters;
+
+	characters = _mm_loadu_si128((const __m128i*) block);
+	*spaceMask = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(characters, _mm_set1_epi8(' ')));
+
+	return _mm_movemask_epi8(characters) == 0 ? 0 : -1;
+
+#else
+
+	register int blockIndex;
+	unsigned int mask, highBits;
+
+	mask = 0;
+	highBits = 0;
+	for (blockIndex = 0; blockIndex < MORSE_BULK_BLOCK; blockIndex++) {
+		mask |= (unsigned int) (block[blockIndex] == ' ') << blockIndex;
+		highBits |= (unsigned char) block[blockIndex];
+	}
+	*spaceMask = mask;
+
+	return (highBits & 0x80) == 0 ? 0 : -1;
+
+#endif
+}
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL BULK FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_initBulkEncoder(MorseBulkEncoder *encoder, BisTree *checkMap, const MorseDialect *dialect) {
+
+	register int asciiIndex;
+	int letterLen, separatorLen;
+	char asciiChar;
+	char *morseSingleString;
+
+	separatorLen = strlen(dialect->letterSeparator);
+	encoder->separatorLen = (unsigned char) separatorLen;
+	encoder->isNarrow = 1;
+
+
+	/* Copy every letter out of the dictionary, so the output is exactly the */
+	/* Same as morse_convAsciiToMorseEx() writes with the same dictionary */
+	for (asciiIndex = 0; asciiIndex < 128; asciiIndex++) {
+
+		memset((void*) encoder->code[asciiIndex], 0, MORSE_BULK_ENTRY);
+		encoder->length[asciiIndex] = 0;
+
+		asciiChar = (char) asciiIndex;
+		if (bst_findElement(checkMap, (void*) &asciiChar, (void**) &morseSingleString) == -1)
+			continue;
+
+		letterLen = strlen(morseSingleString);
+		if (letterLen == 0 || letterLen + separatorLen > MORSE_BULK_ENTRY) return -1;
+
+		memcpy((void*) encoder->code[asciiIndex], (const void*) morseSingleString, letterLen);
+		memcpy((void*) (encoder->code[asciiIndex] + letterLen),
+							(const void*) dialect->letterSeparator, separatorLen);
+		encoder->length[asciiIndex] = (unsigned char) letterLen;
+		if (letterLen + separatorLen > MORSE_BULK_ENTRY / 2) encoder->isNarrow = 0;
+	}
+
+	return 0;
+}
+
+
+
+
+int morse_convAsciiToMorseBulk(const MorseBulkEncoder *encoder,
+								char *AsciiInputString, int AsciiStringLen,
+								char *morseOutputString, int *morseStringLen)
+{
+
+	register int globalInputIndex;
+	register int blockIndex;
+	int globalOutputCounter, letterLen;
+	unsigned int spaceMask, noSeparatorMask, separatorLen, isNarrow;
+	unsigned char asciiIndex;
+
+	globalInputIndex = 0;
+	globalOutputCounter = 0;
+	separatorLen = encoder->separatorLen;
+	isNarrow = encoder->isNarrow;
+
+
+	/* Every character writes at least one byte, so with more than MORSE_BULK_ENTRY */
+	/* Characters still to come, a full entry store never passes the final output */
+	while (AsciiStringLen - globalInputIndex > MORSE_BULK_BLOCK + MORSE_BULK_ENTRY) {
+
+		if (morse_classifyBulkBlock((const char*) AsciiInputString + globalInputIndex,
+													&spaceMask) == -1) return -1;
+
+
+		/* No letter separator after a SPACE, nor in front of a SPACE */
+		/* Bit 16 of the mask is the first character of the next block */
+		spaceMask |= (unsigned int) (AsciiInputString[globalInputIndex + MORSE_BULK_BLOCK] == ' ')
+														<< MORSE_BULK_BLOCK;
+		noSeparatorMask = spaceMask | (spaceMask >> 1);
+
+		for (blockIndex = 0; blockIndex < MORSE_BULK_BLOCK; blockIndex++) {
+
+			asciiIndex = (unsigned char) AsciiInputString[globalInputIndex + blockIndex];
+			letterLen = encoder->length[asciiIndex];
+			if (letterLen == 0) return -1;
+
+			if (isNarrow == 1)
+				memcpy((void*) (morseOutputString + globalOutputCounter),
+							(const void*) encoder->code[asciiIndex], MORSE_BULK_ENTRY / 2);
+			else
+				memcpy((void*) (morseOutputString + globalOutputCounter),
+							(const void*) encoder->code[asciiIndex], MORSE_BULK_ENTRY);
+			globalOutputCounter += letterLen
+							+ (separatorLen & (((noSeparatorMask >> blockIndex) & 1) - 1));
+		}
+
+		globalInputIndex += MORSE_BULK_BLOCK;
+	}
+
+
+	/* The last characters are copied with their exact lengths */
+	while (globalInputIndex < AsciiStringLen) {
+
+		asciiIndex = (unsigned char) AsciiInputString[globalInputIndex];
+		if (asciiIndex >= 128 || encoder->length[asciiIndex] == 0) return -1;
+
+		letterLen = encoder->length[asciiIndex];
+		if (globalInputIndex + 1 < AsciiStringLen
+					&& asciiIndex != ' ' && AsciiInputString[globalInputIndex + 1] != ' ')
+			letterLen += separatorLen;
+
+		memcpy((void*) (morseOutputString + globalOutputCounter),
+							(const void*) encoder->code[asciiIndex], letterLen);
+		globalOutputCounter += letterLen;
+		globalInputIndex = globalInputIndex + 1;
+	}
+
+	*morseStringLen = globalOutputCounter;
+
+	return 0;
+}
@@ -0,0 +1,549 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Conversion Cache
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "MorseLib_Cache.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+#define MORSE_CACHE_FNV_BASIS 2166136261UL
+#define MORSE_CACHE_FNV_PRIME 16777619UL
+#define MORSE_CACHE_LOW_WATER(arenaSize) ((arenaSize) - (arenaSize) / 4)
+
+
+
+/*
+ *
+ * Internal (Static) function to hash a key, FNV-1a over the input bytes
+ * Followed by the direction and options, folded to 32 bits
+ *
+*/
+static unsigned long morse_hashCacheKey(int direction, unsigned long options,
+								const char *input, int inputLen);
+
+
+
+/*
+ *
+ * Internal (Static) function to find an entry of a shard, -1 if not cached
+ * The caller holds the shard lock
+ *
+*/
+static int morse_findCacheEntry(MorseCache *cache, MorseCacheShard *shard, unsigned long hash,
+								int direction, unsigned long options,
+								const char *input, int inputLen);
+
+
+
+/*
+ *
+ * Internal (Static) functions to evict the next entry in CLOCK order, and to move
+ * All live records to the front of the arena. The caller holds the shard lock
+ *
+*/
+static int morse_evictCacheEntry(MorseCache *cache, MorseCacheShard *shard);
+
+static void morse_compactCacheArena(MorseCache *cache, MorseCacheShard *shard);
+
+
+
+/*
+ *
+ * Internal (Static) function to compare two (offset, entry index) pairs by offset
+ * Used by qsort() during compaction
+ *
+*/
+static int morse_compareCacheOffsets(const void *pair1, const void *pair2);
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL CACHE FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_createCache(MorseCache *cache, int shardCount, int entryCount, int arenaSize) {
+
+	return morse_createCacheWith(cache, shardCount, entryCount, arenaSize, &morse_defaultAllocator);
+}
+
+
+
+
+int morse_createCacheWith(MorseCache *cache, int shardCount, int entryCount, int arenaSize,
+								const MorseAllocator *allocator)
+{
+
+	register int shardIndex, entryIndex;
+	int count;
+	size_t shardsSize, entriesSize, indexSize;
+	char *memorySpace;
+	MorseCacheShard *shard;
+
+	if (shardCount <= 0 || entryCount <= 0 || arenaSize <= 0) return -1;
+
+	count = 1;
+	while (count < shardCount) count = count << 1;
+
+
+	/* One single allocation: shards, then all entries, then the bucket and */
+	/* Compaction arrays, then all arenas. Each part keeps the next one aligned */
+	shardsSize = count * sizeof(MorseCacheShard);
+	entriesSize = (size_t) count * entryCount * sizeof(MorseCacheEntry);
+	indexSize = (size_t) count * entryCount * sizeof(int);
+
+
+	/* The compaction array holds (offset, entry index) pairs, so twice the size */
+	memorySpace = (char*) allocator->allocate(allocator->userData,
+						shardsSize + entriesSize + 3 * indexSize + (size_t) count * arenaSize);
+	if (memorySpace == 0) return -1;
+
+	cache->shardCount = count;
+	cache->entryCount = entryCount;
+	cache->arenaSize = arenaSize;
+	cache->shards = (MorseCacheShard*) memorySpace;
+	cache->allocator = allocator;
+
+	for (shardIndex = 0; shardIndex < count; shardIndex++) {
+
+		shard = cache->shards + shardIndex;
+		memset((void*) shard, 0, sizeof(MorseCacheShard));
+
+		shard->entries = (MorseCacheEntry*) (memorySpace + shardsSize) + shardIndex * entryCount;
+		shard->buckets = (int*) (memorySpace + shardsSize + entriesSize) + shardIndex * entryCount;
+		shard->compactOrder = (int*) (memorySpace + shardsSize + entriesSize + indexSize)
+										+ 2 * shardIndex * entryCount;
+		shard->arena = memorySpace + shardsSize + entriesSize + 3 * indexSize
+										+ (size_t) shardIndex * arenaSize;
+
+
+		/* Every entry starts on the free list, every bucket empty */
+		for (entryIndex = 0; entryIndex < entryCount; entryIndex++) {
+			shard->entries[entryIndex].offset = -1;
+			shard->entries[entryIndex].next = entryIndex + 1 < entryCount ? entryIndex + 1 : -1;
+			shard->buckets[entryIndex] = -1;
+		}
+		shard->freeEntry = 0;
+
+		if (pthread_mutex_init(&shard->lock, 0) != 0) {
+			while (shardIndex-- > 0) pthread_mutex_destroy(&cache->shards[shardIndex].lock);
+			allocator->release(allocator->userData, (void*) memorySpace);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+
+
+
+void morse_destroyCache(MorseCache *cache) {
+
+	register int shardIndex;
+
+	for (shardIndex = 0; shardIndex < cache->shardCount; shardIndex++)
+		pthread_mutex_destroy(&cache->shards[shardIndex].lock);
+
+	cache->allocator->release(cache->allocator->userData, (void*) cache->shards);
+	memset((void*) cache, 0, sizeof(MorseCache));
+}
+
+
+
+
+unsigned long morse_getDialectKey(const MorseDialect *dialect) {
+
+	const char *glyphs[4];
+	unsigned long key;
+	register int glyphIndex;
+	const char *glyph;
+
+	if (dialect == 0) dialect = &morse_nativeDialect;
+
+	glyphs[0] = dialect->dotGlyph;
+	glyphs[1] = dialect->dashGlyph;
+	glyphs[2] = dialect->letterSeparator;
+	glyphs[3] = dialect->wordSeparator;
+
+
+	/* The glyph strings are hashed with a 0 byte after each, so "ab" + "c" */
+	/* And "a" + "bc" stay apart */
+	key = MORSE_CACHE_FNV_BASIS;
+	for (glyphIndex = 0; glyphIndex < 4; glyphIndex++) {
+		for (glyph = glyphs[glyphIndex]; *glyph != '\0'; glyph++)
+			key = ((key ^ (unsigned char) *glyph) * MORSE_CACHE_FNV_PRIME) & 0xFFFFFFFFUL;
+		key = (key * MORSE_CACHE_FNV_PRIME) & 0xFFFFFFFFUL;
+	}
+	key = ((key ^ (unsigned long) dialect->wordGapSpaces) * MORSE_CACHE_FNV_PRIME) & 0xFFFFFFFFUL;
+
+	return key;
+}
+
+
+
+
+static unsigned long morse_hashCacheKey(int direction, unsigned long options,
+								const char *input, int inputLen)
+{
+
+	register int inputIndex;
+	unsigned long hash;
+
+	hash = MORSE_CACHE_FNV_BASIS;
+	for (inputIndex = 0; inputIndex < inputLen; inputIndex++)
+		hash = ((hash ^ (unsigned char) input[inputIndex]) * MORSE_CACHE_FNV_PRIME) & 0xFFFFFFFFUL;
+
+	hash = ((hash ^ (unsigned long) direction) * MORSE_CACHE_FNV_PRIME) & 0xFFFFFFFFUL;
+	hash = ((hash ^ (options & 0xFFFFFFFFUL)) * MORSE_CACHE_FNV_PRIME) & 0xFFFFFFFFUL;
+
+
+	/* Final avalanche, the low bits pick the shard and the high bits the bucket */
+	hash = hash ^ (hash >> 15);
+	hash = (hash * 0x2C1B3C6DUL) & 0xFFFFFFFFUL;
+	hash = hash ^ (hash >> 12);
+
+	return hash;
+}
+
+
+
+
+static int morse_findCacheEntry(MorseCache *cache, MorseCacheShard *shard, unsigned long hash,
+								int direction, unsigned long options,
+								const char *input, int inputLen)
+{
+
+	int entryIndex;
+	MorseCacheEntry *entry;
+
+	entryIndex = shard->buckets[(hash / cache->shardCount) % cache->entryCount];
+	while (entryIndex != -1) {
+
+		entry = shard->entries + entryIndex;
+		if (entry->hash == hash && entry->direction == direction && entry->options == options
+				&& entry->inputLen == inputLen
+				&& memcmp((const void*) (shard->arena + entry->offset),
+							(const void*) input, inputLen) == 0) {
+			return entryIndex;
+		}
+		entryIndex = entry->next;
+	}
+
+	return -1;
+}
+
+
+
+
+int morse_lookupCache(MorseCache *cache, int direction, unsigned long options,
+								const char *input, int inputLen, char *output, int *outputLen)
+{
+
+	unsigned long hash;
+	int entryIndex;
+	MorseCacheShard *shard;
+	MorseCacheEntry *entry;
+
+	hash = morse_hashCacheKey(direction, options, input, inputLen);
+	shard = cache->shards + (hash & (cache->shardCount - 1));
+
+
+	pthread_mutex_lock(&shard->lock);
+
+	entryIndex = morse_findCacheEntry(cache, shard, hash, direction, options, input, inputLen);
+	if (entryIndex == -1) {
+		shard->misses = shard->misses + 1;
+		pthread_mutex_unlock(&shard->lock);
+		return -1;
+	}
+
+	entry = shard->entries + entryIndex;
+	memcpy((void*) output, (const void*) (shard->arena + entry->offset + entry->inputLen),
+				entry->outputLen);
+	*outputLen = entry->outputLen;
+	entry->isReferenced = 1;
+	shard->hits = shard->hits + 1;
+
+	pthread_mutex_unlock(&shard->lock);
+
+	return 0;
+}
+
+
+
+
+static int morse_evictCacheEntry(MorseCache *cache, MorseCacheShard *shard) {
+
+	register int step;
+	int entryIndex, *link;
+	MorseCacheEntry *entry;
+
+
+	/* Second chance: a referenced entry loses its bit and survives one more turn */
+	/* Two full turns always find a victim, unless the shard is empty */
+	for (step = 0; step < 2 * cache->entryCount; step++) {
+
+		entryIndex = shard->clockHand;
+		shard->clockHand = (shard->clockHand + 1) % cache->entryCount;
+
+		entry = shard->entries + entryIndex;
+		if (entry->offset == -1) continue;
+		if (entry->isReferenced != 0) {
+			entry->isReferenced = 0;
+			continue;
+		}
+
+
+		/* Unlink the victim from its bucket, then put it on the free list */
+		link = shard->buckets + (entry->hash / cache->shardCount) % cache->entryCount;
+		while (*link != entryIndex) link = &shard->entries[*link].next;
+		*link = entry->next;
+
+		shard->liveBytes -= entry->inputLen + entry->outputLen;
+		entry->offset = -1;
+		entry->next = shard->freeEntry;
+		shard->freeEntry = entryIndex;
+		shard->evictions = shard->evictions + 1;
+
+		return 0;
+	}
+
+	return -1;
+}
+
+
+
+
+static void morse_compactCacheArena(MorseCache *cache, MorseCacheShard *shard) {
+
+	register int entryIndex;
+	int liveCount, current, newOffset;
+	int *order;
+	MorseCacheEntry *entry;
+
+
+	/* Live entries sorted by arena offset, then every record slides down over the holes */
+	order = shard->compactOrder;
+	liveCount = 0;
+	for (entryIndex = 0; entryIndex < cache->entryCount; entryIndex++) {
+
+		if (shard->entries[entryIndex].offset == -1) continue;
+
+		order[2 * liveCount] = shard->entries[entryIndex].offset;
+		order[2 * liveCount + 1] = entryIndex;
+		liveCount = liveCount + 1;
+	}
+
+	qsort((void*) order, liveCount, 2 * sizeof(int), morse_compareCacheOffsets);
+
+	newOffset = 0;
+	for (current = 0; current < liveCount; current++) {
+
+		entry = shard->entries + order[2 * current + 1];
+		if (entry->offset != newOffset) {
+			memmove((void*) (shard->arena + newOffset), (const void*) (shard->arena + entry->offset),
+						entry->inputLen + entry->outputLen);
+			entry->offset = newOffset;
+		}
+		newOffset += entry->inputLen + entry->outputLen;
+	}
+
+	shard->arenaUsed = newOffset;
+	shard->compactions = shard->compactions + 1;
+}
+
+
+
+
+static int morse_compareCacheOffsets(const void *pair1, const void *pair2) {
+
+	return *(const int*) pair1 - *(const int*) pair2;
+}
+
+
+
+
+int morse_storeCache(MorseCache *cache, int direction, unsigned long options,
+								const char *input, int inputLen, const char *output, int outputLen)
+{
+
+	unsigned long hash;
+	int entryIndex, recordSize, *bucket;
+	MorseCacheShard *shard;
+	MorseCacheEntry *entry;
+
+	if (inputLen < 0 || outputLen < 0) return -1;
+
+	recordSize = inputLen + outputLen;
+	if (recordSize > cache->arenaSize / 4) return -1;
+
+	hash = morse_hashCacheKey(direction, options, input, inputLen);
+	shard = cache->shards + (hash & (cache->shardCount - 1));
+
+	pthread_mutex_lock(&shard->lock);
+
+
+	/* Another thread may have stored the same conversion meanwhile */
+	if (morse_findCacheEntry(cache, shard, hash, direction, options, input, inputLen) != -1) {
+		pthread_mutex_unlock(&shard->lock);
+		return 0;
+	}
+
+	while (shard->freeEntry == -1) morse_evictCacheEntry(cache, shard);
+
+
+	/* Without room at the end of the arena, evict until the live records plus */
+	/* This one fill no more than three quarters of it, then close the holes */
+	/* The free quarter takes many inserts before the next compaction */
+	if (shard->arenaUsed + recordSize > cache->arenaSize) {
+		while (shard->liveBytes + recordSize > MORSE_CACHE_LOW_WATER(cache->arenaSize)) {
+			if (morse_evictCacheEntry(cache, shard) == -1) break;
+		}
+		morse_compactCacheArena(cache, shard);
+	}
+
+	entryIndex = shard->freeEntry;
+	entry = shard->entries + entryIndex;
+	shard->freeEntry = entry->next;
+
+	entry->hash = hash;
+	entry->options = options;
+	entry->direction = direction;
+	entry->inputLen = inputLen;
+	entry->outputLen = outputLen;
+	entry->offset = shard->arenaUsed;
+	entry->isReferenced = 0;
+
+	memcpy((void*) (shard->arena + entry->offset), (const void*) input, inputLen);
+	memcpy((void*) (shard->arena + entry->offset + inputLen), (const void*) output, outputLen);
+	shard->arenaUsed += recordSize;
+	shard->liveBytes += recordSize;
+
+	bucket = shard->buckets + (hash / cache->shardCount) % cache->entryCount;
+	entry->next = *bucket;
+	*bucket = entryIndex;
+	shard->insertions = shard->insertions + 1;
+
+	pthread_mutex_unlock(&shard->lock);
+
+	return 0;
+}
+
+
+
+
+int morse_convCached(MorseCache *cache, int direction, BisTree *checkMap, unsigned long dictionaryId,
+								const MorseDialect *dialect,
+								char *inputString, int inputLen, char *outputString, int *outputLen)
+{
+
+	unsigned long options;
+	int returnResult;
+
+	if (dialect == 0) dialect = &morse_nativeDialect;
+
+
+	/* Options are the dialect key (or 0) with the dictionary id hashed into it */
+	options = 0;
+	if (direction == MORSE_CACHE_ASCII_TO_MORSE || direction == MORSE_CACHE_MORSE_TO_ASCII)
+		options = morse_getDialectKey(dialect);
+	if (dictionaryId != 0)
+		options = ((options ^ (dictionaryId & 0xFFFFFFFFUL)) * MORSE_CACHE_FNV_PRIME) & 0xFFFFFFFFUL;
+
+	if (morse_lookupCache(cache, direction, options, inputString, inputLen,
+							outputString, outputLen) == 0) {
+		return 0;
+	}
+
+	switch (direction) {
+
+		case MORSE_CACHE_ASCII_TO_MORSE:
+			returnResult = morse_convAsciiToMorseEx(checkMap, dialect, inputString, inputLen,
+													outputString, outputLen);
+			break;
+
+		case MORSE_CACHE_MORSE_TO_ASCII:
+			returnResult = morse_convMorseToAsciiEx(checkMap, dialect, inputString, inputLen,
+													outputString, outputLen);
+			break;
+
+		case MORSE_CACHE_MORSE_TO_BINARY:
+			returnResult = morse_convMorseToBinary(checkMap, inputString, inputLen,
+													outputString, outputLen);
+			break;
+
+		case MORSE_CACHE_BINARY_TO_MORSE:
+			returnResult = morse_convBinaryToMorse(checkMap, inputString, inputLen,
+													outputString, outputLen);
+			break;
+
+		default:
+			return -1;
+	}
+
+	if (returnResult == 0)
+		morse_storeCache(cache, direction, options, inputString, inputLen, outputString, *outputLen);
+
+	return returnResult;
+}
+
+
+
+
+void morse_getCacheStats(MorseCache *cache, MorseCacheStats *stats) {
+
+	register int shardIndex;
+	MorseCacheShard *shard;
+
+	memset((void*) stats, 0, sizeof(MorseCacheStats));
+
+	for (shardIndex = 0; shardIndex < cache->shardCount; shardIndex++) {
+
+		shard = cache->shards + shardIndex;
+
+		pthread_mutex_lock(&shard->lock);
+		stats->hits += shard->hits;
+		stats->misses += shard->misses;
+		stats->insertions += shard->insertions;
+		stats->evictions += shard->evictions;
+		stats->compactions += shard->compactions;
+		stats->bytes += (unsigned long) shard->liveBytes;
+		pthread_mutex_unlock(&shard->lock);
+	}
+	stats->entries = stats->insertions - stats->evictions;
+}
@@ -0,0 +1,192 @@
+
+
+/************************************************************************************
+	Program Interface of Morse Library Conversion Cache
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef MORSELIB_CACHE_H
+#define MORSELIB_CACHE_H
+
+
+
+
+
+
+
+#include <pthread.h>
+#include "MorseLib.h"
+
+
+
+/*
+ * Bounded cache of finished conversion outputs, for traffic which repeats a lot
+ * (Beacons, call signs, contest exchanges). An entry is found by a hash of its
+ * Input bytes, its conversion direction and an options value (eg. the dialect)
+ * So a repeated message becomes one lookup plus a memcpy()
+ *
+ * The cache is split into shards by hash, each shard has its own lock, entry
+ * Table and byte arena holding inputs and outputs back to back. A lookup only
+ * Holds its shard for one memcmp() and memcpy(), so readers of different
+ * Messages seldom meet on the same lock
+ * When a shard is full, entries are evicted in CLOCK order (second chance) and
+ * The arena is compacted
+ *
+ * Needs POSIX threads, link with -lpthread
+*/
+
+#define MORSE_CACHE_ASCII_TO_MORSE 0
+#define MORSE_CACHE_MORSE_TO_ASCII 1
+#define MORSE_CACHE_MORSE_TO_BINARY 2
+#define MORSE_CACHE_BINARY_TO_MORSE 3
+#define MORSE_CACHE_USER 16					/* First direction free for the caller */
+
+
+
+typedef struct MorseCacheEntry_ {
+
+	unsigned long hash;
+	unsigned long options;
+	int direction;
+	int inputLen;
+	int outputLen;
+	int offset;								/* Arena offset of input then output, -1 if free */
+	int next;								/* Next entry of the bucket (or free list), -1 at end */
+	int isReferenced;						/* CLOCK bit, set by lookups */
+
+} MorseCacheEntry;
+
+
+
+typedef struct MorseCacheShard_ {
+
+	pthread_mutex_t lock;
+
+	MorseCacheEntry *entries;
+	int *buckets;							/* First entry of each bucket, -1 if empty */
+	int *compactOrder;						/* Scratch for compaction, (offset, entry) pairs */
+	char *arena;
+
+	int arenaUsed;
+	int liveBytes;
+	int clockHand;
+	int freeEntry;
+
+	unsigned long hits;
+	unsigned long misses;
+	unsigned long insertions;
+	unsigned long evictions;
+	unsigned long compactions;
+
+} MorseCacheShard;
+
+
+
+typedef struct MorseCache_ {
+
+	int shardCount;
+	int entryCount;							/* Entries of one shard */
+	int arenaSize;							/* Arena bytes of one shard */
+	MorseCacheShard *shards;
+
+	const MorseAllocator *allocator;
+
+} MorseCache;
+
+
+
+typedef struct MorseCacheStats_ {
+
+	unsigned long hits;
+	unsigned long misses;
+	unsigned long insertions;
+	unsigned long evictions;
+	unsigned long compactions;
+	unsigned long entries;					/* Entries cached right now */
+	unsigned long bytes;					/* Arena bytes in use by them */
+
+} MorseCacheStats;
+
+
+
+/*
+	Create a cache of shardCount shards (rounded up to a power of 2), each one
+	holding at most entryCount entries in arenaSize bytes of input and output
+
+	Returns 0 for success, -1 for memory allocation failure
+	One must call morse_destroyCache() after being done with the cache
+*/
+
+int morse_createCache(MorseCache *cache, int shardCount, int entryCount, int arenaSize);
+
+int morse_createCacheWith(MorseCache *cache, int shardCount, int entryCount, int arenaSize,
+								const MorseAllocator *allocator);
+
+void morse_destroyCache(MorseCache *cache);
+
+
+
+/*
+	Key of a dialect, to be used as options value
+	Dialects which write the same glyphs and separators have the same key
+*/
+
+unsigned long morse_getDialectKey(const MorseDialect *dialect);
+
+
+
+/*
+	Look up or store one conversion output
+	morse_lookupCache() copies a cached output to output (which must be as large as
+	the conversion itself would need) and returns 0, or returns -1 for a miss
+
+	morse_storeCache() keeps a copy of the output, unless it is larger than a
+	quarter of the shard arena. Returns 0 if stored or already cached, -1 otherwise
+*/
+
+int morse_lookupCache(MorseCache *cache, int direction, unsigned long options,
+								const char *input, int inputLen, char *output, int *outputLen);
+
+int morse_storeCache(MorseCache *cache, int direction, unsigned long options,
+								const char *input, int inputLen, const char *output, int outputLen);
+
+
+
+/*
+	Cached form of the four conversions, same contracts as morse_convAsciiToMorseEx(),
+	morse_convMorseToAsciiEx(), morse_convMorseToBinary() and morse_convBinaryToMorse()
+	The dialect is only used by the first two, give 0 for the native dialect
+	Failed conversions are never cached
+
+	dictionaryId is part of the key and names checkMap: the cache cannot tell two
+	BisTrees apart, so every dictionary used with one cache and direction needs an
+	Id of its own (eg. ASCII-To-Morse mappings of two dialects). A single dictionary
+	Per direction may simply use 0
+*/
+
+int morse_convCached(MorseCache *cache, int direction, BisTree *checkMap, unsigned long dictionaryId,
+								const MorseDialect *dialect,
+								char *inputString, int inputLen, char *outputString, int *outputLen);
+
+
+
+/*
+	Sum of the statistics of all shards
+*/
+
+void morse_getCacheStats(MorseCache *cache, MorseCacheStats *stats);
+
+
+
+
+
+
+
+#endif
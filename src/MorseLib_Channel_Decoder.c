@@ -0,0 +1,310 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Multi-Channel Binary Decoder
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <limits.h>
+#include <string.h>
+#include "MorseLib.h"
+
+
+
+
+/* C90 has no restrict, GCC and Clang accept their own spelling in -ansi mode */
+#if defined(__GNUC__)
+#define MORSE_RESTRICT __restrict__
+#else
+#define MORSE_RESTRICT
+#endif
+
+
+
+
+
+
+/*
+ * Morse character for a binary segment, indexed by the count of '1' before its '0'
+ * Same mapping as morse_createBinaryToMorseMapping() builds into its BisTree
+*/
+static const char segmentToMorse[4] = {
+	MORSE_DOT, MORSE_DASH, MORSE_LETTER_SEPARATOR, MORSE_WORD_SEPARATOR
+};
+
+
+
+/*
+ * Internal (Static) function which advances every channel by one binary character
+ * Phase 1 (morse_stepChannelStates) updates the decoder states, phase 2 scatters
+ * The closed segments into their ring buffers
+*/
+static int morse_stepChannels(MorseChannelBank *bank, const char *frame);
+
+
+
+/*
+ * Internal (Static) function for phase 1 of a step. Only unsigned char arithmetic
+ * Over non-aliasing arrays and no branches, so GCC vectorizes the loop with -O3
+ * (Or -O2 -ftree-vectorize). Check with -fopt-info-vec
+ * Returns the OR of all channel status bytes
+*/
+static unsigned char morse_stepChannelStates(int channelCount, const char *MORSE_RESTRICT frame,
+								unsigned char *MORSE_RESTRICT onesCount,
+								unsigned char *MORSE_RESTRICT channelStatus,
+								unsigned char *MORSE_RESTRICT emitFlag,
+								unsigned char *MORSE_RESTRICT emitSymbol);
+
+
+
+
+
+
+
+#ifndef MORSE_FREESTANDING
+int morse_createChannelBank(MorseChannelBank *bank, int channelCount, int ringCapacity) {
+
+	return morse_createChannelBankWith(bank, channelCount, ringCapacity, &morse_defaultAllocator);
+}
+#endif
+
+
+
+
+int morse_createChannelBankWith(MorseChannelBank *bank, int channelCount, int ringCapacity,
+								const MorseAllocator *allocator)
+{
+
+	unsigned int capacity;
+	size_t byteArraysSize, indexArraysSize, ringsSize;
+	char *memorySpace;
+
+	/* The capacity is rounded up to a power of 2 and must still fit an int, */
+	/* As morse_readChannel() reports up to one full ring */
+	if (channelCount <= 0 || ringCapacity <= 0) return -1;
+	if (ringCapacity > INT_MAX / 2 + 1) return -1;
+
+	capacity = 1;
+	while (capacity < (unsigned int) ringCapacity) capacity = capacity << 1;
+
+
+	/* One single allocation: index arrays first (alignment), then byte arrays, */
+	/* Then all ring buffers back to back. Sizes are checked against size_t overflow */
+	if ((size_t) channelCount > (size_t) -1 / (2 * sizeof(unsigned int) + 5)) return -1;
+	indexArraysSize = 2 * (size_t) channelCount * sizeof(unsigned int);
+	byteArraysSize = 5 * (size_t) channelCount * sizeof(unsigned char);
+
+	if ((size_t) capacity > ((size_t) -1 - indexArraysSize - byteArraysSize)
+									/ (size_t) channelCount) return -1;
+	ringsSize = (size_t) channelCount * capacity;
+
+	memorySpace = (char*) allocator->allocate(allocator->userData,
+						indexArraysSize + byteArraysSize + ringsSize);
+	if (memorySpace == 0) return -1;
+
+	bank->channelCount = channelCount;
+	bank->ringMask = capacity - 1;
+	bank->ringHead = (unsigned int*) memorySpace;
+	bank->ringTail = bank->ringHead + channelCount;
+	bank->onesCount = (unsigned char*) (memorySpace + indexArraysSize);
+	bank->channelStatus = bank->onesCount + channelCount;
+	bank->emitFlag = bank->channelStatus + channelCount;
+	bank->emitSymbol = bank->emitFlag + channelCount;
+	bank->gatherFrame = (char*) (bank->emitSymbol + channelCount);
+	bank->ringMemory = memorySpace + indexArraysSize + byteArraysSize;
+	bank->allocator = allocator;
+
+	memset((void*) memorySpace, 0, indexArraysSize + byteArraysSize);
+
+	return 0;
+}
+
+
+
+
+void morse_destroyChannelBank(MorseChannelBank *bank) {
+
+	bank->allocator->release(bank->allocator->userData, (void*) bank->ringHead);
+	memset((void*) bank, 0, sizeof(MorseChannelBank));
+}
+
+
+
+
+void morse_resetChannel(MorseChannelBank *bank, int channel) {
+
+	if (channel < 0 || channel >= bank->channelCount) return;
+
+	bank->onesCount[channel] = 0;
+	bank->channelStatus[channel] = MORSE_CHANNEL_OK;
+	bank->ringHead[channel] = 0;
+	bank->ringTail[channel] = 0;
+}
+
+
+
+
+int morse_getChannelStatus(MorseChannelBank *bank, int channel) {
+
+	if (channel < 0 || channel >= bank->channelCount) return -1;
+	return bank->channelStatus[channel];
+}
+
+
+
+
+static int morse_stepChannels(MorseChannelBank *bank, const char *frame) {
+
+	register int channel;
+	int channelCount;
+	unsigned int tail, capacity;
+	unsigned char anyFault;
+	unsigned char *channelStatus, *emitFlag, *emitSymbol;
+
+	channelCount = bank->channelCount;
+	channelStatus = bank->channelStatus;
+	emitFlag = bank->emitFlag;
+	emitSymbol = bank->emitSymbol;
+
+
+	/* Phase 1: lockstep update of every channel */
+	anyFault = morse_stepChannelStates(channelCount, frame, bank->onesCount,
+										channelStatus, emitFlag, emitSymbol);
+
+
+	/* Phase 2: scatter closed segments to their per-channel ring buffers */
+	capacity = bank->ringMask + 1;
+	for (channel = 0; channel < channelCount; channel++) {
+
+		if (emitFlag[channel] == 0) continue;
+
+		tail = bank->ringTail[channel];
+		if (tail - bank->ringHead[channel] == capacity) {
+			channelStatus[channel] |= MORSE_CHANNEL_OVERFLOW;
+			anyFault = 1;
+			continue;
+		}
+		bank->ringMemory[(size_t) channel * capacity + (tail & bank->ringMask)] =
+										segmentToMorse[emitSymbol[channel]];
+		bank->ringTail[channel] = tail + 1;
+	}
+
+	return anyFault == 0 ? 0 : -1;
+}
+
+
+
+
+static unsigned char morse_stepChannelStates(int channelCount, const char *MORSE_RESTRICT frame,
+								unsigned char *MORSE_RESTRICT onesCount,
+								unsigned char *MORSE_RESTRICT channelStatus,
+								unsigned char *MORSE_RESTRICT emitFlag,
+								unsigned char *MORSE_RESTRICT emitSymbol)
+{
+
+	register int channel;
+	unsigned char isOne, isZero, ones, status, anyStatus;
+
+
+	/* A '1' extends the open segment, a fourth '1' is invalid (longest is 1110) */
+	/* A '0' closes the segment, its morse character is selected by onesCount */
+	/* Every value is 0 or 1 except ones (0 to 3 while valid), so there are no */
+	/* Compares to bool: ones == 3 is (ones >> 1) & ones, a '1' mask is -isOne */
+	anyStatus = 0;
+	for (channel = 0; channel < channelCount; channel++) {
+
+		isOne = (unsigned char) (frame[channel] == '1');
+		isZero = (unsigned char) (frame[channel] == '0');
+		ones = onesCount[channel];
+		status = channelStatus[channel];
+
+		status = (unsigned char) (status | ((isOne | isZero) ^ 1) | (isOne & (ones >> 1) & ones));
+		emitFlag[channel] = (unsigned char) (isZero & ~status & MORSE_CHANNEL_INVALID);
+		emitSymbol[channel] = ones;
+		onesCount[channel] = (unsigned char) ((ones + 1) & -isOne);
+		channelStatus[channel] = status;
+		anyStatus = (unsigned char) (anyStatus | status);
+	}
+
+	return anyStatus;
+}
+
+
+
+
+int morse_decodeChannelsInterleaved(MorseChannelBank *bank, char *binaryFrames, int frameCount) {
+
+	register int frameIndex;
+	int returnResult;
+
+	returnResult = 0;
+	for (frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+		returnResult |= morse_stepChannels(bank,
+						(const char*) binaryFrames + (size_t) frameIndex * bank->channelCount);
+	}
+
+	return returnResult;
+}
+
+
+
+
+int morse_decodeChannelBlocks(MorseChannelBank *bank, char **binaryBlocks, int blockLen) {
+
+	register int frameIndex, channel;
+	int returnResult;
+	char *frame;
+
+
+	/* Gather one character of every block into a frame, then step the bank */
+	frame = bank->gatherFrame;
+	returnResult = 0;
+	for (frameIndex = 0; frameIndex < blockLen; frameIndex++) {
+
+		for (channel = 0; channel < bank->channelCount; channel++)
+			frame[channel] = binaryBlocks[channel][frameIndex];
+
+		returnResult |= morse_stepChannels(bank, (const char*) frame);
+	}
+
+	return returnResult;
+}
+
+
+
+
+int morse_readChannel(MorseChannelBank *bank, int channel,
+								char *morseOutputString, int maxLen, int *morseStringLen)
+{
+
+	unsigned int head, available, firstPart, offset;
+	char *ring;
+
+	if (channel < 0 || channel >= bank->channelCount) return -1;
+
+	head = bank->ringHead[channel];
+	available = bank->ringTail[channel] - head;
+	if (maxLen >= 0 && available > (unsigned int) maxLen) available = (unsigned int) maxLen;
+
+
+	/* The readable region may wrap around the end of the ring, copy in two parts */
+	ring = bank->ringMemory + (size_t) channel * (bank->ringMask + 1);
+	offset = head & bank->ringMask;
+	firstPart = bank->ringMask + 1 - offset;
+	if (firstPart > available) firstPart = available;
+
+	memcpy((void*) morseOutputString, (const void*) (ring + offset), firstPart);
+	memcpy((void*) (morseOutputString + firstPart), (const void*) ring, available - firstPart);
+
+	bank->ringHead[channel] = head + available;
+	*morseStringLen = (int) available;
+
+	return 0;
+}
@@ -15,7 +15,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <queue.h>
+#include <limits.h>
 #include <bst.h>
 #include "MorseLib.h"
 
@@ -34,6 +34,304 @@ int cmp_character(const void *k1, const void *k2);
 
 
 
+/*
+ *
+ * Function to search a flat dictionary (MorseDictionary) by bisection
+ * Returns 0 and the value of the key, -1 if there is no such key
+ * Implemented in MorseLib_Utility_Functions.c
+ *
+*/
+int morse_findDictionaryEntry(const MorseDictionary *dictionary, const char *key,
+								const char **value);
+
+
+
+
+
+
+/*
+ *
+ * Output writer shared by every conversion algorithm below
+ * The algorithms never touch their output memory directly, they hand each piece
+ * Of output to morse_writeOutput(), which places it into one of three targets:
+ *
+ *		- One contiguous caller allocated array (unbounded, the classic interface)
+ *		- A list of caller owned segments, filled one after another
+ *		- A block buffer which is handed to a sink function every time it fills
+ *		- Nothing at all, only the output length is counted (length queries)
+ *
+ * Output is split across block boundaries as needed, so it is never copied twice
+ *
+*/
+typedef struct MorseWriter_ {
+
+	char *cursor;					/* Next byte of output goes here */
+	char *blockStart;
+	char *blockEnd;
+	int isBounded;					/* 0 for one contiguous unbounded array */
+	int isCounting;					/* 1 if output is only counted, never stored */
+	size_t outputLen;				/* Total number of bytes written so far */
+
+	MorseSegment *segments;			/* Scatter-gather target, or 0 */
+	int segmentCount;
+	int segmentIndex;
+
+	MorseSink *sink;				/* Callback target, or 0 */
+	char localBlock[256];			/* Used when the sink does not bring a block */
+
+} MorseWriter;
+
+
+
+static void morse_initBufferWriter(MorseWriter *writer, char *outputString);
+
+static int morse_initSegmentWriter(MorseWriter *writer, MorseSegment *segments, int segmentCount);
+
+static void morse_initSinkWriter(MorseWriter *writer, MorseSink *sink);
+
+static void morse_initCountWriter(MorseWriter *writer);
+
+
+
+/*
+ * Write dataLen bytes of output, moving on to the next block whenever one fills
+ * Returns 0 for success, -1 if segments are exhausted, the sink failed or the
+ * Output length would not fit into a size_t
+*/
+static int morse_writeOutput(MorseWriter *writer, const char *data, int dataLen);
+
+
+
+/*
+ * Current block is full: hand it to the sink, or move on to the next segment
+ * Returns 0 for success, -1 if there is no more room
+*/
+static int morse_nextOutputBlock(MorseWriter *writer);
+
+
+
+/*
+ * Hand the last (partially filled) block to the sink, if there is one
+ * Returns 0 for success, -1 if the sink failed
+*/
+static int morse_finishOutput(MorseWriter *writer);
+
+
+
+/*
+ * The four conversion algorithms, all writing through a MorseWriter
+ * Lengths are size_t throughout, the int interfaces only check the result
+ * Letters come from the flat dictionary if one is given, from checkMap otherwise
+ * Each returns 0 for successful conversion, -1 otherwise
+*/
+static int morse_runAsciiToMorse(BisTree *checkMap, const MorseDictionary *dictionary,
+								const MorseDialect *dialect,
+								char *AsciiInputString, size_t AsciiStringLen, MorseWriter *writer);
+
+static int morse_runMorseToAscii(BisTree *checkMap, const MorseDictionary *dictionary,
+								const MorseDialect *dialect,
+								char *morseInputString, size_t morseStringLen, MorseWriter *writer);
+
+static int morse_runNativeMorseToAscii(BisTree *checkMap, const MorseDictionary *dictionary,
+								char *morseInputString, size_t morseStringLen, MorseWriter *writer);
+
+static int morse_runMorseToBinary(BisTree *checkMap, const MorseDictionary *dictionary,
+								char *morseInputSequence, size_t morseSequenceLen, MorseWriter *writer);
+
+static int morse_runBinaryToMorse(BisTree *checkMap, const MorseDictionary *dictionary,
+								char *binaryInputString, size_t binarySequenceLen, MorseWriter *writer);
+
+
+
+/*
+ * Look up one key in the flat dictionary, or in checkMap if there is none
+ * Returns 0 and the value of the key, -1 if there is no such key
+*/
+static int morse_findLetter(BisTree *checkMap, const MorseDictionary *dictionary,
+								const char *key, char **value);
+
+
+
+/*
+ * Length of an int interface input, negative lengths convert nothing (as always)
+ * And the int form of an output length, -1 if it does not fit into an int
+*/
+static size_t morse_inputLength(int length);
+
+static int morse_outputLength(MorseWriter *writer, int *length);
+
+
+
+
+
+
+
+
+
+static void morse_initBufferWriter(MorseWriter *writer, char *outputString) {
+
+	writer->cursor = outputString;
+	writer->blockStart = outputString;
+	writer->blockEnd = 0;
+	writer->isBounded = 0;
+	writer->isCounting = 0;
+	writer->outputLen = 0;
+	writer->segments = 0;
+	writer->sink = 0;
+}
+
+
+
+
+static int morse_initSegmentWriter(MorseWriter *writer, MorseSegment *segments, int segmentCount) {
+
+	writer->cursor = writer->blockStart = writer->blockEnd = 0;
+	writer->isBounded = 1;
+	writer->isCounting = 0;
+	writer->outputLen = 0;
+	writer->segments = segments;
+	writer->segmentCount = segmentCount;
+	writer->segmentIndex = -1;
+	writer->sink = 0;
+
+	/* Load the first usable segment, an empty output needs none at all */
+	return segmentCount > 0 ? morse_nextOutputBlock(writer) : 0;
+}
+
+
+
+
+static void morse_initSinkWriter(MorseWriter *writer, MorseSink *sink) {
+
+	if (sink->block != 0 && sink->blockSize > 0) {
+		writer->blockStart = sink->block;
+		writer->blockEnd = sink->block + sink->blockSize;
+	} else {
+		writer->blockStart = writer->localBlock;
+		writer->blockEnd = writer->localBlock + sizeof(writer->localBlock);
+	}
+
+	writer->cursor = writer->blockStart;
+	writer->isBounded = 1;
+	writer->isCounting = 0;
+	writer->outputLen = 0;
+	writer->segments = 0;
+	writer->sink = sink;
+}
+
+
+
+
+static void morse_initCountWriter(MorseWriter *writer) {
+
+	writer->cursor = writer->blockStart = writer->blockEnd = 0;
+	writer->isBounded = 0;
+	writer->isCounting = 1;
+	writer->outputLen = 0;
+	writer->segments = 0;
+	writer->sink = 0;
+}
+
+
+
+
+static size_t morse_inputLength(int length) {
+
+	return length > 0 ? (size_t) length : 0;
+}
+
+
+
+
+static int morse_outputLength(MorseWriter *writer, int *length) {
+
+	if (writer->outputLen > (size_t) INT_MAX) return -1;
+
+	*length = (int) writer->outputLen;
+	return 0;
+}
+
+
+
+
+static int morse_nextOutputBlock(MorseWriter *writer) {
+
+	MorseSegment *segment;
+
+	if (writer->sink != 0) {
+		if (writer->sink->write(writer->sink->userData, (const char*) writer->blockStart,
+						writer->cursor - writer->blockStart) != 0)
+			return -1;
+		writer->cursor = writer->blockStart;
+		return 0;
+	}
+
+
+	/* Skip over empty segments, fail when we run out of segments */
+	do {
+		writer->segmentIndex = writer->segmentIndex + 1;
+		if (writer->segmentIndex >= writer->segmentCount) return -1;
+		segment = writer->segments + writer->segmentIndex;
+	} while (segment->length <= 0);
+
+	writer->cursor = writer->blockStart = segment->base;
+	writer->blockEnd = segment->base + segment->length;
+
+	return 0;
+}
+
+
+
+
+static int morse_writeOutput(MorseWriter *writer, const char *data, int dataLen) {
+
+	int blockRoom;
+
+	if ((size_t) dataLen > (size_t) -1 - writer->outputLen) return -1;
+
+
+	/* Classic contiguous output, no boundaries to care about */
+	if (writer->isBounded == 0) {
+		if (writer->isCounting == 1) {
+			writer->outputLen += dataLen;
+			return 0;
+		}
+		memcpy((void*) writer->cursor, (const void*) data, dataLen);
+		writer->cursor += dataLen;
+		writer->outputLen += dataLen;
+		return 0;
+	}
+
+	while (dataLen > 0) {
+
+		if (writer->cursor == writer->blockEnd && morse_nextOutputBlock(writer) == -1)
+			return -1;
+
+		blockRoom = writer->blockEnd - writer->cursor;
+		if (blockRoom > dataLen) blockRoom = dataLen;
+
+		memcpy((void*) writer->cursor, (const void*) data, blockRoom);
+		writer->cursor += blockRoom;
+		writer->outputLen += blockRoom;
+		data = data + blockRoom;
+		dataLen = dataLen - blockRoom;
+	}
+
+	return 0;
+}
+
+
+
+
+static int morse_finishOutput(MorseWriter *writer) {
+
+	if (writer->sink == 0 || writer->cursor == writer->blockStart) return 0;
+
+	return morse_nextOutputBlock(writer);
+}
+
+
+
 
 
 
@@ -61,36 +359,67 @@ int cmp_character(const void *k1, const void *k2);
 int morse_convAsciiToMorse (BisTree *checkMap, char *AsciiInputString, int AsciiStringLen,
     							char *morseOutputString, int *morseStringLen)
 {
+	return morse_convAsciiToMorseEx(checkMap, &morse_nativeDialect,
+							AsciiInputString, AsciiStringLen, morseOutputString, morseStringLen);
+}
+
+
+
+/*
+	Dialect aware variant of morse_convAsciiToMorse()
+	Letter separator is taken from the dialect, word separator and glyphs come
+	From the checkMap built by morse_createAsciiToMorseMappingEx()
+*/
+
+int morse_convAsciiToMorseEx (BisTree *checkMap, const MorseDialect *dialect,
+								char *AsciiInputString, int AsciiStringLen,
+    							char *morseOutputString, int *morseStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, morseOutputString);
+	if (morse_runAsciiToMorse(checkMap, 0, dialect, AsciiInputString, morse_inputLength(AsciiStringLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, morseStringLen);
+}
+
+
+
+
+static int morse_runAsciiToMorse(BisTree *checkMap, const MorseDictionary *dictionary,
+								const MorseDialect *dialect,
+								char *AsciiInputString, size_t AsciiStringLen, MorseWriter *writer)
+{
 
 
-	register int globalInputIndex;
+	register size_t globalInputIndex;
 	int findResult;
-	register int globalOutputCounter;
 	char *currentAscii, *morseSingleString;
-	char morseLetterSeparator;
+	const char *morseLetterSeparator;
 	char spaceChar;
-	int morseSingleLen;
+	int morseSingleLen, letterSeparatorLen;
 
-	unsigned int hasNextAscii, nextIsSpace, writtenBar;
+	unsigned int hasNextAscii, nextIsSpace, writtenWordSeparator;
 	unsigned int writeLetterSeparator;
 
 	findResult = -1;
 	globalInputIndex = 0;
-	globalOutputCounter = 0;
 	spaceChar = ' ';
-	morseLetterSeparator = MORSE_LETTER_SEPARATOR;
+	morseLetterSeparator = dialect->letterSeparator;
+	letterSeparatorLen = strlen(morseLetterSeparator);
 
 	while ( globalInputIndex < AsciiStringLen ) {
 
 		currentAscii = AsciiInputString + globalInputIndex;
-		findResult = bst_findElement(checkMap, (void*) currentAscii, (void**) &morseSingleString);
+		findResult = morse_findLetter(checkMap, dictionary, currentAscii, &morseSingleString);
 
 		if (findResult == -1) return -1;
 
 		morseSingleLen = strlen(morseSingleString);
-		memcpy((void *) morseOutputString + globalOutputCounter,
-		       (const void *) morseSingleString, morseSingleLen);
-		globalOutputCounter = globalOutputCounter + morseSingleLen;
+		if (morse_writeOutput(writer, (const char*) morseSingleString, morseSingleLen) == -1)
+			return -1;
 
 		/*	detect if it is necessary to write a letter separator on the output stream	*/
 		hasNextAscii = globalInputIndex == AsciiStringLen - 1 ? 0 : 1;
@@ -98,21 +427,16 @@ int morse_convAsciiToMorse (BisTree *checkMap, char *AsciiInputString, int Ascii
 					  &&
 		              (cmp_character((const void*) AsciiInputString + globalInputIndex + 1,
 					  (const void*) &spaceChar) == 0) ? 1 : 0;
-		writtenBar = *(morseOutputString + globalOutputCounter - 1) == MORSE_WORD_SEPARATOR ?
-		             1 : 0;
-		writeLetterSeparator = hasNextAscii & !(nextIsSpace | writtenBar);
-		
-/*		printf("hasNextAscii: %d nextSpace: %d writtenBar: %d\n", hasNextAscii, nextSpace, writtenBar);*/
-
-		if (writeLetterSeparator == 1) {
-			memcpy((void *) (morseOutputString + globalOutputCounter),
-			       (const void *) &morseLetterSeparator, sizeof(char));
-			globalOutputCounter = globalOutputCounter + sizeof(char);
-		}
+		writtenWordSeparator = cmp_character((const void*) currentAscii,
+					  (const void*) &spaceChar) == 0 ? 1 : 0;
+		writeLetterSeparator = hasNextAscii & !(nextIsSpace | writtenWordSeparator);
+
+		if (writeLetterSeparator == 1
+			&& morse_writeOutput(writer, morseLetterSeparator, letterSeparatorLen) == -1)
+			return -1;
 
 		globalInputIndex = globalInputIndex + 1;
 	}
-	*morseStringLen = globalOutputCounter;
 
 	return 0;
 }
@@ -143,267 +467,986 @@ int morse_convAsciiToMorse (BisTree *checkMap, char *AsciiInputString, int Ascii
 int morse_convMorseToAscii (BisTree *checkMap, char *morseInputString, int morseStringLen,
     							char *AsciiOutputString, int *AsciiStringLen)
 {
+	return morse_convMorseToAsciiEx(checkMap, &morse_nativeDialect,
+							morseInputString, morseStringLen, AsciiOutputString, AsciiStringLen);
+}
 
 
-	register int letterIndex;
-	int findResult;
-	register int globalInputIndex, globalOutputCounter;
-	char spaceChar, nulTerminator;
-	char *currentMorseChar, *asciiChar, tempMorseBuffer[20];
 
-	globalInputIndex = 0;
-	globalOutputCounter = 0;
-	spaceChar = ' ';
-	nulTerminator = '\0';
-
-	while (globalInputIndex < morseStringLen) {
-
-		letterIndex = globalInputIndex;
-		currentMorseChar = morseInputString + letterIndex;
-		
-		
-		/* Ahead of us, the next character(s) can be morse word separator (|) */
-		/* We have to skip next characters util we find a normal morse character */
-		/* But, a word separator means a SPACE character ( ), and should be written */
-		/* a SPACE character in Output ASCII stream for each Word Separator we skip */
-		while (*currentMorseChar == MORSE_WORD_SEPARATOR) {
-
-			memcpy((void*) AsciiOutputString + globalOutputCounter,
-									(const void*) &spaceChar, sizeof(char));
-			globalOutputCounter += sizeof(char);
-			
-			letterIndex = letterIndex + 1;
-			currentMorseChar = morseInputString + letterIndex;
-		}
+/*
+ * Internal (Static) function to test whether a glyph of glyphLen bytes starts at the
+ * Given input position. The caller measures each glyph once, not per character
+ * Returns length of the glyph if it matches, 0 otherwise (an empty glyph never matches)
+*/
+static int morse_matchGlyph(const char *input, size_t inputLen, const char *glyph, size_t glyphLen) {
 
-		
-		/* We assume that we've skipped all word separators in the Input Stream */
-		/* We are now ready to handle another valid Morse character sequence */
-		/* But, a Letter Separator can be present in Input stream this moment */
-		/* If this is the case, we simply skip 1 character for Letter Separator */
-		if (*currentMorseChar == MORSE_LETTER_SEPARATOR) {
-			letterIndex = letterIndex + 1;
-			currentMorseChar = morseInputString + letterIndex;
-		}
-		
-		/* Update globalInputIndex, its going to be used below */
-		globalInputIndex = letterIndex;
+	if (glyphLen == 0 || glyphLen > inputLen) return 0;
 
+	return memcmp((const void*) input, (const void*) glyph, glyphLen) == 0 ? (int) glyphLen : 0;
+}
 
-		/* Search for length of a single letter in morse code	*/
-		/* It means, search for the next Separator character in the input stream */
-		/* When we get a separator, the characters counted thus far whould be */
-		/* a sequence of character in morse, which identifies a character in ASCII */
-		while ( letterIndex < morseStringLen
-		        && *currentMorseChar != MORSE_LETTER_SEPARATOR
-		        && *currentMorseChar != MORSE_WORD_SEPARATOR ) {
 
-			letterIndex = letterIndex + 1;
-			currentMorseChar = morseInputString + letterIndex;
-		}
-		
-		/* If following expression becomes true, the above while loop did not run at all */
-		/* It actually means, we have reached at the end of the input stream (no error) */
-		if (letterIndex == globalInputIndex) goto EXIT_FUNCTION;
 
-		/* We found a sequence of morse character, now get the corresponding ASCII char */
-		/* First we copy the sequence into a temporary character buffer */
-		memcpy((void*) tempMorseBuffer,
-				(const void*) morseInputString + globalInputIndex, letterIndex - globalInputIndex);
-		*(tempMorseBuffer + letterIndex - globalInputIndex) = nulTerminator;
+/*
+ * Internal (Static) function to test whether a dialect is the native one
+ * ("." "-" "/" "|", no blank gaps), which has a single character fast path
+*/
+static int morse_isNativeDialect(const MorseDialect *dialect) {
+
+	if (dialect == &morse_nativeDialect) return 1;
 
+	return strcmp(dialect->dotGlyph, ".") == 0 && strcmp(dialect->dashGlyph, "-") == 0
+			&& strcmp(dialect->letterSeparator, "/") == 0
+			&& strcmp(dialect->wordSeparator, "|") == 0 && dialect->wordGapSpaces == 0;
+}
 
-		/* Now use the Morse sequence in buffer to find the corresponding ASCII character */
-		/* If not found, the morse sequence is probably invalid, and we return abnormally */
-		findResult = bst_findElement(checkMap, (void*) tempMorseBuffer, (void**) &asciiChar);
-		if (findResult == -1) return -1;
 
 
-		/* Copy the ASCII character we've found into the Output stream */
-		/* In addition to that, we also increment the OutputCounter variable by 1 */
-		memcpy((void*) AsciiOutputString + globalOutputCounter,
-								(const void*) asciiChar, sizeof(char));
-			   
-		globalOutputCounter += sizeof(char);
-		globalInputIndex = letterIndex;
-	}
+static int morse_findLetter(BisTree *checkMap, const MorseDictionary *dictionary,
+								const char *key, char **value)
+{
+
+	const char *entryValue;
 
-	EXIT_FUNCTION:
-	*AsciiStringLen = globalOutputCounter;
+	if (dictionary == 0) return bst_findElement(checkMap, (void*) key, (void**) value);
 
+	if (morse_findDictionaryEntry(dictionary, key, &entryValue) == -1) return -1;
+
+	*value = (char*) entryValue;
 	return 0;
 }
 
 
 
+/*
+ * Internal (Static) function to look up one gathered letter and write its ASCII character
+ * Returns 0 for success, -1 for an unknown letter or a failed write
+*/
+static int morse_writeMorseLetter(BisTree *checkMap, const MorseDictionary *dictionary,
+								char *morseLetter, int letterLen, MorseWriter *writer)
+{
 
+	char *asciiChar;
 
+	*(morseLetter + letterLen) = '\0';
+	if (morse_findLetter(checkMap, dictionary, morseLetter, &asciiChar) == -1)
+		return -1;
 
+	/* One byte into a plain array needs none of the block bookkeeping */
+	if (writer->isBounded == 0 && writer->isCounting == 0) {
+		*writer->cursor++ = *asciiChar;
+		writer->outputLen += sizeof(char);
+		return 0;
+	}
 
+	return morse_writeOutput(writer, (const char*) asciiChar, sizeof(char));
+}
 
-/*
-	Converts morse string into binary bit string
-	You can obtain a BisTree Binary-to-Morse mapping through the function
-	morse_createBinaryToMorseMapping(BisTree *binaryToMorse)
 
-	in:
-		BisTree *checkMap			- Mapping of Morse characters to Binary strings
-		char *morseInputString		- Morse string for input, eg. .../---/... (SOS)
-		int morseStringLen			- Length of morse string input
-	out:
-		char *binaryOutputString	- Pre-allocated memory space to hold binary bit characters
-									  as output. Will not contain NUL terminator (\0) at the end
-		int *binaryStringLen		- Length of binary bits output
 
-	Returns 0 for successfule convertion, -1 otherwisw
+/*
+ * Internal (Static) function to strip the blanks around a separator, eg. " / " becomes "/"
+ * Returns length of the core, which starts at *core
 */
+static size_t morse_separatorCore(const char *separator, const char **core) {
 
+	size_t coreLen;
 
-int morse_convMorseToBinary (BisTree *checkMap, char *morseInputSequence, int morseSequenceLen,
-    							char *binaryOutputSequence, int *binarySequenceLen)
-{
-
-
-	register int globalInputIndex;
-	register int globalOutputCounter;
-	char *morseCharToken, *binaryTokenString;
-	int searchResult;
+	while (*separator == ' ') separator = separator + 1;
+	coreLen = strlen(separator);
+	while (coreLen > 0 && *(separator + coreLen - 1) == ' ') coreLen = coreLen - 1;
 
-	globalInputIndex = globalOutputCounter = 0;
-	binaryTokenString = 0;
+	*core = separator;
+	return coreLen;
+}
 
-	while (globalInputIndex < morseSequenceLen) {
 
-		morseCharToken = morseInputSequence + globalInputIndex;
-		searchResult = bst_findElement(checkMap, (void*) morseCharToken, (void**) &binaryTokenString);
 
-		if (searchResult == -1) return -1;
+/*
+	Dialect aware variant of morse_convMorseToAscii()
+	Glyphs are normalized to native dots and dashes while scanning, so the
+	Ordinary Morse-To-ASCII dictionary is used for every dialect
+*/
 
-		strcpy(binaryOutputSequence + globalOutputCounter, (const char*) binaryTokenString);
+int morse_convMorseToAsciiEx (BisTree *checkMap, const MorseDialect *dialect,
+								char *morseInputString, int morseStringLen,
+    							char *AsciiOutputString, int *AsciiStringLen)
+{
 
-		globalOutputCounter += strlen(binaryTokenString);
-		globalInputIndex = globalInputIndex + 1;
-	}
+	MorseWriter writer;
 
-	*binarySequenceLen = globalOutputCounter;
+	morse_initBufferWriter(&writer, AsciiOutputString);
+	if (morse_runMorseToAscii(checkMap, 0, dialect, morseInputString, morse_inputLength(morseStringLen), &writer) == -1)
+		return -1;
 
-	return 0;
+	return morse_outputLength(&writer, AsciiStringLen);
 }
 
 
 
 
+static int morse_runMorseToAscii(BisTree *checkMap, const MorseDictionary *dictionary,
+								const MorseDialect *dialect,
+								char *morseInputString, size_t morseStringLen, MorseWriter *writer)
+{
 
 
+	register size_t globalInputIndex;
+	char spaceChar;
+	int letterLen, glyphLen, blanksAreGaps;
+	size_t wordCoreLen, letterCoreLen, dotGlyphLen, dashGlyphLen;
+	const char *wordCore, *letterCore;
+	char *currentInput, tempMorseBuffer[20];
+	size_t inputLeft, blankCount;
+	int isWordGap, isLetterGap;
 
-/*
-	Converts binary bit string into morse string
-	You can obtain a BisTree Morse-To-Binary mapping through the function
-	morse_createMorseToBinaryMapping(BisTree *morseToBinary)
 
-	in:
-		BisTree *checkMap			- Mapping of Binary string to Morse characters
-		char *bnaryInputString		- Binary string for input, eg. 1101001101101010
-		int binaryStringLen			- Length of binary string input
-	out:
-		char *morseOutputString		- Pre-allocated memory space to hold morse characters
-									  as output. Will not contain NUL terminator (\0) at the end
-		int *morseStringLen			- Length of morse characters output
+	/* The native dialect (every classic caller) needs no glyph matching */
+	if (morse_isNativeDialect(dialect) == 1)
+		return morse_runNativeMorseToAscii(checkMap, dictionary, morseInputString, morseStringLen, writer);
 
-	Returns 0 for successfule convertion, -1 otherwisw
-*/
 
+	/* A separator is matched by its core, the blanks around it are optional */
+	/* Blanks are gaps by themselves only if the dialect uses them at all */
+	wordCoreLen = morse_separatorCore(dialect->wordSeparator, &wordCore);
+	letterCoreLen = morse_separatorCore(dialect->letterSeparator, &letterCore);
+	blanksAreGaps = dialect->wordGapSpaces > 0
+					|| strchr(dialect->letterSeparator, ' ') != 0
+					|| strchr(dialect->wordSeparator, ' ') != 0;
 
-int morse_convBinaryToMorse (BisTree *checkMap, char *binaryInputString, int binarySequenceLen,
-    							char *morseOutputString, int *morseSequenceLen)
-{
+	dotGlyphLen = strlen(dialect->dotGlyph);
+	dashGlyphLen = strlen(dialect->dashGlyph);
 
-	Queue binaryCharQueue;
+	globalInputIndex = 0;
+	spaceChar = ' ';
+	letterLen = 0;
 
-	register int globalInputIndex;
-	register int bufferCounter;
-	int globalOutputCounter;
+	while (globalInputIndex <= morseStringLen) {
 
-	int searchResult;
-	int returnResult;
+		currentInput = morseInputString + globalInputIndex;
+		inputLeft = morseStringLen - globalInputIndex;
+		isWordGap = isLetterGap = 0;
 
-	char currentInputChar;
-	char binaryBuffer[20];
-	char *binaryDigit, *morseCharToken;
 
-	globalInputIndex = 0;
-	bufferCounter = 0;
-	globalOutputCounter = 0;
-	returnResult = 0;
-	queue_init(&binaryCharQueue, 0);
+		/* Dots and dashes of the current letter are gathered in native form */
+		/* Besides the dialect glyphs, the plain ASCII ones and the typographic */
+		/* Middle dot (U+00B7) and minus sign (U+2212) are always accepted */
+		if (inputLeft > 0) {
 
-	while (globalInputIndex < binarySequenceLen) {
+			if ((glyphLen = morse_matchGlyph(currentInput, inputLeft, dialect->dotGlyph, dotGlyphLen)) > 0
+				|| (glyphLen = morse_matchGlyph(currentInput, inputLeft, ".", 1)) > 0
+				|| (glyphLen = morse_matchGlyph(currentInput, inputLeft, "\xC2\xB7", 2)) > 0) {
+
+				if (letterLen == sizeof(tempMorseBuffer) - 1) return -1;
+				*(tempMorseBuffer + letterLen++) = MORSE_DOT;
+				globalInputIndex += glyphLen;
+				continue;
+			}
+			if ((glyphLen = morse_matchGlyph(currentInput, inputLeft, dialect->dashGlyph, dashGlyphLen)) > 0
+				|| (glyphLen = morse_matchGlyph(currentInput, inputLeft, "-", 1)) > 0
+				|| (glyphLen = morse_matchGlyph(currentInput, inputLeft, "\xE2\x88\x92", 3)) > 0) {
+
+				if (letterLen == sizeof(tempMorseBuffer) - 1) return -1;
+				*(tempMorseBuffer + letterLen++) = MORSE_DASH;
+				globalInputIndex += glyphLen;
+				continue;
+			}
+
+
+			/* Not a glyph, so a separator starts here, possibly with blanks first */
+			blankCount = 0;
+			if (blanksAreGaps != 0) {
+				while (blankCount < inputLeft && *(currentInput + blankCount) == ' ')
+					blankCount = blankCount + 1;
+			}
+
+			if (wordCoreLen > 0 && blankCount + wordCoreLen <= inputLeft
+				&& memcmp((const void*) (currentInput + blankCount),
+						  (const void*) wordCore, wordCoreLen) == 0) {
+
+				/* Word separator core, eat the blanks which follow it as well */
+				isWordGap = 1;
+				blankCount = blankCount + wordCoreLen;
+				while (blanksAreGaps != 0 && blankCount < inputLeft
+						&& *(currentInput + blankCount) == ' ')
+					blankCount = blankCount + 1;
+			}
+			else if (blankCount > 0) {
+
+				/* Only blanks: a word gap if long enough, a letter gap otherwise */
+				if (dialect->wordGapSpaces > 0 && blankCount >= (size_t) dialect->wordGapSpaces)
+					isWordGap = 1;
+				else
+					isLetterGap = 1;
+			}
+			else if (letterCoreLen > 0 && letterCoreLen <= inputLeft
+				&& memcmp((const void*) currentInput, (const void*) letterCore, letterCoreLen) == 0) {
+
+				isLetterGap = 1;
+				blankCount = letterCoreLen;
+			}
+			else {
+				return -1;
+			}
+		}
+
+
+		/* Any gap (or the end of input) closes the current letter */
+		/* Find the corresponding ASCII character of the gathered morse sequence */
+		if (letterLen > 0) {
+			if (morse_writeMorseLetter(checkMap, dictionary, tempMorseBuffer, letterLen, writer) == -1)
+				return -1;
+			letterLen = 0;
+		}
+
+		if (isWordGap == 1 && morse_writeOutput(writer, &spaceChar, sizeof(char)) == -1)
+			return -1;
+
+		if (inputLeft == 0) break;
+		globalInputIndex += blankCount;
+	}
+
+	return 0;
+}
+
+
+
+
+
+static int morse_runNativeMorseToAscii(BisTree *checkMap, const MorseDictionary *dictionary,
+								char *morseInputString, size_t morseStringLen, MorseWriter *writer)
+{
+
+
+	register size_t globalInputIndex;
+	int letterLen, glyphLen;
+	char spaceChar, tempMorseBuffer[20];
+	char *currentInput;
+
+
+	/* Same results as the dialect scanner for the native dialect, one switch per */
+	/* Character. Only the typographic dot and dash need a multi byte compare */
+	spaceChar = ' ';
+	letterLen = 0;
+
+	for (globalInputIndex = 0; globalInputIndex < morseStringLen; globalInputIndex++) {
+
+		currentInput = morseInputString + globalInputIndex;
+
+		switch (*currentInput) {
+
+			case MORSE_DOT:
+			case MORSE_DASH:
+				if (letterLen == sizeof(tempMorseBuffer) - 1) return -1;
+				*(tempMorseBuffer + letterLen++) = *currentInput;
+				continue;
+
+			case MORSE_LETTER_SEPARATOR:
+			case MORSE_WORD_SEPARATOR:
+				break;
+
+			default:
+				if ((glyphLen = morse_matchGlyph(currentInput, morseStringLen - globalInputIndex,
+												"\xC2\xB7", 2)) > 0) {
+					if (letterLen == sizeof(tempMorseBuffer) - 1) return -1;
+					*(tempMorseBuffer + letterLen++) = MORSE_DOT;
+					globalInputIndex += glyphLen - 1;
+					continue;
+				}
+				if ((glyphLen = morse_matchGlyph(currentInput, morseStringLen - globalInputIndex,
+												"\xE2\x88\x92", 3)) > 0) {
+					if (letterLen == sizeof(tempMorseBuffer) - 1) return -1;
+					*(tempMorseBuffer + letterLen++) = MORSE_DASH;
+					globalInputIndex += glyphLen - 1;
+					continue;
+				}
+				return -1;
+		}
+
+
+		/* Either separator closes the current letter, a word separator adds a SPACE */
+		if (letterLen > 0) {
+			if (morse_writeMorseLetter(checkMap, dictionary, tempMorseBuffer, letterLen, writer) == -1)
+				return -1;
+			letterLen = 0;
+		}
+
+		if (*currentInput == MORSE_WORD_SEPARATOR
+			&& morse_writeOutput(writer, &spaceChar, sizeof(char)) == -1)
+			return -1;
+	}
+
+
+	/* The end of input closes the last letter */
+	if (letterLen > 0 && morse_writeMorseLetter(checkMap, dictionary, tempMorseBuffer, letterLen, writer) == -1)
+		return -1;
+
+	return 0;
+}
+
+
+
+
+
+
+
+
+/*
+	Converts morse string into binary bit string
+	You can obtain a BisTree Binary-to-Morse mapping through the function
+	morse_createBinaryToMorseMapping(BisTree *binaryToMorse)
+
+	in:
+		BisTree *checkMap			- Mapping of Morse characters to Binary strings
+		char *morseInputString		- Morse string for input, eg. .../---/... (SOS)
+		int morseStringLen			- Length of morse string input
+	out:
+		char *binaryOutputString	- Pre-allocated memory space to hold binary bit characters
+									  as output. Will not contain NUL terminator (\0) at the end
+		int *binaryStringLen		- Length of binary bits output
+
+	Returns 0 for successfule convertion, -1 otherwisw
+*/
+
+
+int morse_convMorseToBinary (BisTree *checkMap, char *morseInputSequence, int morseSequenceLen,
+    							char *binaryOutputSequence, int *binarySequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, binaryOutputSequence);
+	if (morse_runMorseToBinary(checkMap, 0, morseInputSequence, morse_inputLength(morseSequenceLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, binarySequenceLen);
+}
+
+
+
+
+static int morse_runMorseToBinary(BisTree *checkMap, const MorseDictionary *dictionary,
+								char *morseInputSequence, size_t morseSequenceLen, MorseWriter *writer)
+{
+
+
+	register size_t globalInputIndex;
+	char *morseCharToken, *binaryTokenString;
+	int searchResult;
+
+	globalInputIndex = 0;
+	binaryTokenString = 0;
+
+	while (globalInputIndex < morseSequenceLen) {
+
+		morseCharToken = morseInputSequence + globalInputIndex;
+		searchResult = morse_findLetter(checkMap, dictionary, morseCharToken, &binaryTokenString);
+
+		if (searchResult == -1) return -1;
+
+		if (morse_writeOutput(writer, (const char*) binaryTokenString,
+								strlen(binaryTokenString)) == -1)
+			return -1;
+
+		globalInputIndex = globalInputIndex + 1;
+	}
+
+	return 0;
+}
+
+
+
+
+
+
+
+/*
+	Converts binary bit string into morse string
+	You can obtain a BisTree Morse-To-Binary mapping through the function
+	morse_createMorseToBinaryMapping(BisTree *morseToBinary)
+
+	in:
+		BisTree *checkMap			- Mapping of Binary string to Morse characters
+		char *bnaryInputString		- Binary string for input, eg. 1101001101101010
+		int binaryStringLen			- Length of binary string input
+	out:
+		char *morseOutputString		- Pre-allocated memory space to hold morse characters
+									  as output. Will not contain NUL terminator (\0) at the end
+		int *morseStringLen			- Length of morse characters output
+
+	Returns 0 for successfule convertion, -1 otherwisw
+*/
+
+
+int morse_convBinaryToMorse (BisTree *checkMap, char *binaryInputString, int binarySequenceLen,
+    							char *morseOutputString, int *morseSequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, morseOutputString);
+	if (morse_runBinaryToMorse(checkMap, 0, binaryInputString, morse_inputLength(binarySequenceLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, morseSequenceLen);
+}
+
+
+
+
+static int morse_runBinaryToMorse(BisTree *checkMap, const MorseDictionary *dictionary,
+								char *binaryInputString, size_t binarySequenceLen, MorseWriter *writer)
+{
+
+	register size_t globalInputIndex;
+	register int bufferCounter;
+
+	int searchResult;
+	int returnResult;
+
+	char currentInputChar;
+	char binaryBuffer[20];
+	char *morseCharToken;
+
+	globalInputIndex = 0;
+	bufferCounter = 0;
+	returnResult = 0;
+
+	while (globalInputIndex < binarySequenceLen) {
+
+		currentInputChar = *(binaryInputString + globalInputIndex);
 
-		currentInputChar = *(binaryInputString + globalInputIndex);
 
-		
-		/* Enqueue the binary character at hand to the Queue for later processing */
-		queue_enqueue(&binaryCharQueue, (void*) (binaryInputString + globalInputIndex));
+		/* Store the binary character at hand to the buffer for later processing */
+		/* No valid segment is that long, so a full buffer is an error already */
+		if (bufferCounter == sizeof(binaryBuffer) - 1) return -1;
+
+		*(binaryBuffer + bufferCounter) = currentInputChar;
+		bufferCounter = bufferCounter + 1;
 		globalInputIndex = globalInputIndex + 1;
 
-		
+
 		/* If current input character at hand is a '0', we have got a full segment */
-		/* In this case, pop all the characters from the Queue and get the Morse character */
+		/* In this case, get the Morse character of the segment in our buffer */
 		if (currentInputChar == '0') {
 
-		
-			/* Dequeue all binary symbols from the Queue and store them to buffer */
-			while (queue_size(&binaryCharQueue) > 0) {
-
-				queue_dequeue(&binaryCharQueue, (void**) &binaryDigit);
-				*(binaryBuffer + bufferCounter) = *binaryDigit;
-				bufferCounter = bufferCounter + 1;
-			}
 
-			
 			/* At the end of our buffer, place a NUL character to mark end of string */
 			*(binaryBuffer + bufferCounter) = '\0';
-			
-			
+
+
 			/* Search for the string from buffer for its corresponding Morse character */
-			searchResult = bst_findElement(checkMap, (void*) binaryBuffer, (void**) &morseCharToken);
+			searchResult = morse_findLetter(checkMap, dictionary, binaryBuffer, &morseCharToken);
 			returnResult = searchResult;
 
-			
+
 			/* If we cant find a Morse character for our binary string, its an error */
-			if (returnResult == -1) goto EXIT_FUNCTION;
+			if (returnResult == -1) return -1;
+
 
-			
 			/* Write the Morse character we have got to the Output stream */
-			*(morseOutputString + globalOutputCounter) = *morseCharToken;
-			globalOutputCounter++;
+			returnResult = morse_writeOutput(writer, (const char*) morseCharToken, sizeof(char));
+			if (returnResult == -1) return -1;
 
-			/* printf("Chunk string in buffer: %s, Morse: %c\n", binaryBuffer, *morseCharToken);*/
 
-			
 			/* Clear the buffer, it is enough to set the buffer length to 0 */
 			bufferCounter = 0;
-			
+
 		} /* End of IF condition (We just processed a single Morse character) */
-		
+
 		/* Start again */
 	}
-	
-	
-	/* Check the size of our temporary binary symbol queue */
-	/* If elements still exist inside the queue, then it is considered an error */
-	if (queue_size(&binaryCharQueue) > 0) {
-		returnResult = -1;
-		goto EXIT_FUNCTION;
-	}
 
-	*morseSequenceLen = globalOutputCounter;
 
-EXIT_FUNCTION:
+	/* Check the size of our temporary binary symbol buffer */
+	/* If symbols still exist inside the buffer, then it is considered an error */
+	if (bufferCounter > 0) return -1;
+
+	return 0;
+}
+
+
+
+
+
+
+
+
+/*
+	Scatter-gather and callback variants of the four conversions
+
+	Same as morse_convAsciiToMorseEx(), but the output is scattered across a list of
+	Caller owned segments, filled in order. A piece of output which does not fit
+	Into the rest of a segment continues at the start of the next one
+
+	out:
+		int *morseStringLen		- Total length of output over all segments
+
+	Returns 0 for successful conversion, -1 on failure or if the segments are too small
+*/
+
+int morse_convAsciiToMorseSegments (BisTree *checkMap, const MorseDialect *dialect,
+								char *AsciiInputString, int AsciiStringLen,
+								MorseSegment *segments, int segmentCount, int *morseStringLen)
+{
+
+	MorseWriter writer;
 
-	/* Clean up and return to the caller */
-	queue_destroy(&binaryCharQueue);
-	return returnResult;
+	if (morse_initSegmentWriter(&writer, segments, segmentCount) == -1
+		|| morse_runAsciiToMorse(checkMap, 0, dialect, AsciiInputString, morse_inputLength(AsciiStringLen), &writer) == -1)
+		return -1;
 
+	return morse_outputLength(&writer, morseStringLen);
 }
 
+
+
+
+/*
+	Same as morse_convAsciiToMorseEx(), but the output is collected in the block of the
+	Sink (or a small internal block) and handed to sink->write() whenever the block
+	Fills, and once more for the last partial block. Output handed to the sink before
+	A failure is not taken back
+
+	Returns 0 for successful conversion, -1 on failure or if sink->write() failed
+*/
+
+int morse_convAsciiToMorseSink (BisTree *checkMap, const MorseDialect *dialect,
+								char *AsciiInputString, int AsciiStringLen,
+								MorseSink *sink, int *morseStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initSinkWriter(&writer, sink);
+	if (morse_runAsciiToMorse(checkMap, 0, dialect, AsciiInputString, morse_inputLength(AsciiStringLen), &writer) == -1
+		|| morse_finishOutput(&writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, morseStringLen);
+}
+
+
+
+
+
+
+
+
+/*
+	Same as morse_convMorseToAsciiEx(), but the output is scattered across a list of
+	Caller owned segments, filled in order. A piece of output which does not fit
+	Into the rest of a segment continues at the start of the next one
+
+	out:
+		int *AsciiStringLen		- Total length of output over all segments
+
+	Returns 0 for successful conversion, -1 on failure or if the segments are too small
+*/
+
+int morse_convMorseToAsciiSegments (BisTree *checkMap, const MorseDialect *dialect,
+								char *morseInputString, int morseStringLen,
+								MorseSegment *segments, int segmentCount, int *AsciiStringLen)
+{
+
+	MorseWriter writer;
+
+	if (morse_initSegmentWriter(&writer, segments, segmentCount) == -1
+		|| morse_runMorseToAscii(checkMap, 0, dialect, morseInputString, morse_inputLength(morseStringLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, AsciiStringLen);
+}
+
+
+
+
+/*
+	Same as morse_convMorseToAsciiEx(), but the output is collected in the block of the
+	Sink (or a small internal block) and handed to sink->write() whenever the block
+	Fills, and once more for the last partial block. Output handed to the sink before
+	A failure is not taken back
+
+	Returns 0 for successful conversion, -1 on failure or if sink->write() failed
+*/
+
+int morse_convMorseToAsciiSink (BisTree *checkMap, const MorseDialect *dialect,
+								char *morseInputString, int morseStringLen,
+								MorseSink *sink, int *AsciiStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initSinkWriter(&writer, sink);
+	if (morse_runMorseToAscii(checkMap, 0, dialect, morseInputString, morse_inputLength(morseStringLen), &writer) == -1
+		|| morse_finishOutput(&writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, AsciiStringLen);
+}
+
+
+
+
+
+
+
+
+/*
+	Same as morse_convMorseToBinary(), but the output is scattered across a list of
+	Caller owned segments, filled in order. A piece of output which does not fit
+	Into the rest of a segment continues at the start of the next one
+
+	out:
+		int *binarySequenceLen		- Total length of output over all segments
+
+	Returns 0 for successful conversion, -1 on failure or if the segments are too small
+*/
+
+int morse_convMorseToBinarySegments (BisTree *checkMap, char *morseInputSequence, int morseSequenceLen,
+								MorseSegment *segments, int segmentCount, int *binarySequenceLen)
+{
+
+	MorseWriter writer;
+
+	if (morse_initSegmentWriter(&writer, segments, segmentCount) == -1
+		|| morse_runMorseToBinary(checkMap, 0, morseInputSequence, morse_inputLength(morseSequenceLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, binarySequenceLen);
+}
+
+
+
+
+/*
+	Same as morse_convMorseToBinary(), but the output is collected in the block of the
+	Sink (or a small internal block) and handed to sink->write() whenever the block
+	Fills, and once more for the last partial block. Output handed to the sink before
+	A failure is not taken back
+
+	Returns 0 for successful conversion, -1 on failure or if sink->write() failed
+*/
+
+int morse_convMorseToBinarySink (BisTree *checkMap, char *morseInputSequence, int morseSequenceLen,
+								MorseSink *sink, int *binarySequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initSinkWriter(&writer, sink);
+	if (morse_runMorseToBinary(checkMap, 0, morseInputSequence, morse_inputLength(morseSequenceLen), &writer) == -1
+		|| morse_finishOutput(&writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, binarySequenceLen);
+}
+
+
+
+
+
+
+
+
+/*
+	Same as morse_convBinaryToMorse(), but the output is scattered across a list of
+	Caller owned segments, filled in order. A piece of output which does not fit
+	Into the rest of a segment continues at the start of the next one
+
+	out:
+		int *morseSequenceLen		- Total length of output over all segments
+
+	Returns 0 for successful conversion, -1 on failure or if the segments are too small
+*/
+
+int morse_convBinaryToMorseSegments (BisTree *checkMap, char *binaryInputString, int binarySequenceLen,
+								MorseSegment *segments, int segmentCount, int *morseSequenceLen)
+{
+
+	MorseWriter writer;
+
+	if (morse_initSegmentWriter(&writer, segments, segmentCount) == -1
+		|| morse_runBinaryToMorse(checkMap, 0, binaryInputString, morse_inputLength(binarySequenceLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, morseSequenceLen);
+}
+
+
+
+
+/*
+	Same as morse_convBinaryToMorse(), but the output is collected in the block of the
+	Sink (or a small internal block) and handed to sink->write() whenever the block
+	Fills, and once more for the last partial block. Output handed to the sink before
+	A failure is not taken back
+
+	Returns 0 for successful conversion, -1 on failure or if sink->write() failed
+*/
+
+int morse_convBinaryToMorseSink (BisTree *checkMap, char *binaryInputString, int binarySequenceLen,
+								MorseSink *sink, int *morseSequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initSinkWriter(&writer, sink);
+	if (morse_runBinaryToMorse(checkMap, 0, binaryInputString, morse_inputLength(binarySequenceLen), &writer) == -1
+		|| morse_finishOutput(&writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, morseSequenceLen);
+}
+
+
+
+
+
+
+
+
+
+/*
+	size_t variants of the four conversions, for buffers of 2 GB and beyond
+	Same contracts as the int interfaces, the output length is accumulated with
+	An overflow check and the conversion fails if it would not fit into a size_t
+*/
+
+int morse_convAsciiToMorseZ (BisTree *checkMap, char *AsciiInputString, size_t AsciiStringLen,
+								char *morseOutputString, size_t *morseStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, morseOutputString);
+	if (morse_runAsciiToMorse(checkMap, 0, &morse_nativeDialect,
+								AsciiInputString, AsciiStringLen, &writer) == -1)
+		return -1;
+
+	*morseStringLen = writer.outputLen;
+
+	return 0;
+}
+
+
+
+
+int morse_convMorseToAsciiZ (BisTree *checkMap, char *morseInputString, size_t morseStringLen,
+								char *AsciiOutputString, size_t *AsciiStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, AsciiOutputString);
+	if (morse_runMorseToAscii(checkMap, 0, &morse_nativeDialect,
+								morseInputString, morseStringLen, &writer) == -1)
+		return -1;
+
+	*AsciiStringLen = writer.outputLen;
+
+	return 0;
+}
+
+
+
+
+int morse_convMorseToBinaryZ (BisTree *checkMap, char *morseInputSequence, size_t morseSequenceLen,
+								char *binaryOutputSequence, size_t *binarySequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, binaryOutputSequence);
+	if (morse_runMorseToBinary(checkMap, 0, morseInputSequence, morseSequenceLen, &writer) == -1)
+		return -1;
+
+	*binarySequenceLen = writer.outputLen;
+
+	return 0;
+}
+
+
+
+
+int morse_convBinaryToMorseZ (BisTree *checkMap, char *binaryInputString, size_t binarySequenceLen,
+								char *morseOutputString, size_t *morseSequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, morseOutputString);
+	if (morse_runBinaryToMorse(checkMap, 0, binaryInputString, binarySequenceLen, &writer) == -1)
+		return -1;
+
+	*morseSequenceLen = writer.outputLen;
+
+	return 0;
+}
+
+
+
+
+
+
+
+
+/*
+	Length queries: run a conversion without storing its output, and give the
+	Exact output length, so the output buffer can be allocated before converting
+
+	Returns 0 for a convertible input, -1 otherwise (or if the length overflows)
+*/
+
+int morse_getAsciiToMorseLengthZ (BisTree *checkMap, char *AsciiInputString, size_t AsciiStringLen,
+								size_t *morseStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initCountWriter(&writer);
+	if (morse_runAsciiToMorse(checkMap, 0, &morse_nativeDialect,
+								AsciiInputString, AsciiStringLen, &writer) == -1)
+		return -1;
+
+	*morseStringLen = writer.outputLen;
+
+	return 0;
+}
+
+
+
+
+int morse_getMorseToAsciiLengthZ (BisTree *checkMap, char *morseInputString, size_t morseStringLen,
+								size_t *AsciiStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initCountWriter(&writer);
+	if (morse_runMorseToAscii(checkMap, 0, &morse_nativeDialect,
+								morseInputString, morseStringLen, &writer) == -1)
+		return -1;
+
+	*AsciiStringLen = writer.outputLen;
+
+	return 0;
+}
+
+
+
+
+int morse_getMorseToBinaryLengthZ (BisTree *checkMap, char *morseInputSequence, size_t morseSequenceLen,
+								size_t *binarySequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initCountWriter(&writer);
+	if (morse_runMorseToBinary(checkMap, 0, morseInputSequence, morseSequenceLen, &writer) == -1)
+		return -1;
+
+	*binarySequenceLen = writer.outputLen;
+
+	return 0;
+}
+
+
+
+
+int morse_getBinaryToMorseLengthZ (BisTree *checkMap, char *binaryInputString, size_t binarySequenceLen,
+								size_t *morseSequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initCountWriter(&writer);
+	if (morse_runBinaryToMorse(checkMap, 0, binaryInputString, binarySequenceLen, &writer) == -1)
+		return -1;
+
+	*morseSequenceLen = writer.outputLen;
+
+	return 0;
+}
+
+
+
+
+
+
+
+
+/*
+	Conversions over a flat MorseDictionary, see morse_createMorseToAsciiDictionaryWith()
+	Same algorithms as the BisTree conversions, only the letters are looked up
+	By bisection in the dictionary
+*/
+
+int morse_convAsciiToMorseDictionary(const MorseDictionary *textToMorse,
+								char *AsciiInputString, int AsciiStringLen,
+								char *morseOutputString, int *morseStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, morseOutputString);
+	if (morse_runAsciiToMorse(0, textToMorse, textToMorse->dialect,
+						AsciiInputString, morse_inputLength(AsciiStringLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, morseStringLen);
+}
+
+
+
+
+int morse_convMorseToAsciiDictionary(const MorseDictionary *morseToText,
+								char *morseInputString, int morseStringLen,
+								char *AsciiOutputString, int *AsciiStringLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, AsciiOutputString);
+	if (morse_runMorseToAscii(0, morseToText, &morse_nativeDialect,
+						morseInputString, morse_inputLength(morseStringLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, AsciiStringLen);
+}
+
+
+
+
+int morse_convMorseToBinaryDictionary(const MorseDictionary *morseToBinary,
+								char *morseInputSequence, int morseSequenceLen,
+								char *binaryOutputSequence, int *binarySequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, binaryOutputSequence);
+	if (morse_runMorseToBinary(0, morseToBinary,
+						morseInputSequence, morse_inputLength(morseSequenceLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, binarySequenceLen);
+}
+
+
+
+
+int morse_convBinaryToMorseDictionary(const MorseDictionary *binaryToMorse,
+								char *binaryInputString, int binarySequenceLen,
+								char *morseOutputString, int *morseSequenceLen)
+{
+
+	MorseWriter writer;
+
+	morse_initBufferWriter(&writer, morseOutputString);
+	if (morse_runBinaryToMorse(0, binaryToMorse,
+						binaryInputString, morse_inputLength(binarySequenceLen), &writer) == -1)
+		return -1;
+
+	return morse_outputLength(&writer, morseSequenceLen);
+}
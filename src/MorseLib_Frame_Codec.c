@@ -0,0 +1,560 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Framed Binary Stream
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <string.h>
+#include "MorseLib.h"
+
+
+
+
+/*
+ * Layout of one frame, every field is written with '0' and '1' characters
+ *
+ *	SYNC	"1111110"
+ *	HEADER	16 bit sequence number and 16 bit payload length, bit stuffed
+ *	PAYLOAD	Binary segments exactly as morse_convMorseToBinary() writes them
+ *	CRC		CRC-32 of header (4 bytes) and payload characters, bit stuffed
+ *
+ * Bit stuffing writes an extra '0' after every run of three '1' in a field
+ * A valid payload never holds more than three '1' in a row either, so a run of
+ * Six '1' can only be a SYNC, and the decoder finds the next frame by a plain
+ * Forward scan, whatever happened to the frame before
+*/
+
+#define MORSE_FRAME_SYNC_ONES 6
+#define MORSE_FRAME_STUFF_ONES 3
+
+#define MORSE_FRAME_FIELD_OK 0
+#define MORSE_FRAME_FIELD_MORE 1			/* Input ended inside the field */
+#define MORSE_FRAME_FIELD_BAD -1
+
+
+
+/* CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) of every byte value */
+static const unsigned long crcTable[256] = {
+	0x00000000UL, 0x77073096UL, 0xEE0E612CUL, 0x990951BAUL, 0x076DC419UL, 0x706AF48FUL,
+	0xE963A535UL, 0x9E6495A3UL, 0x0EDB8832UL, 0x79DCB8A4UL, 0xE0D5E91EUL, 0x97D2D988UL,
+	0x09B64C2BUL, 0x7EB17CBDUL, 0xE7B82D07UL, 0x90BF1D91UL, 0x1DB71064UL, 0x6AB020F2UL,
+	0xF3B97148UL, 0x84BE41DEUL, 0x1ADAD47DUL, 0x6DDDE4EBUL, 0xF4D4B551UL, 0x83D385C7UL,
+	0x136C9856UL, 0x646BA8C0UL, 0xFD62F97AUL, 0x8A65C9ECUL, 0x14015C4FUL, 0x63066CD9UL,
+	0xFA0F3D63UL, 0x8D080DF5UL, 0x3B6E20C8UL, 0x4C69105EUL, 0xD56041E4UL, 0xA2677172UL,
+	0x3C03E4D1UL, 0x4B04D447UL, 0xD20D85FDUL, 0xA50AB56BUL, 0x35B5A8FAUL, 0x42B2986CUL,
+	0xDBBBC9D6UL, 0xACBCF940UL, 0x32D86CE3UL, 0x45DF5C75UL, 0xDCD60DCFUL, 0xABD13D59UL,
+	0x26D930ACUL, 0x51DE003AUL, 0xC8D75180UL, 0xBFD06116UL, 0x21B4F4B5UL, 0x56B3C423UL,
+	0xCFBA9599UL, 0xB8BDA50FUL, 0x2802B89EUL, 0x5F058808UL, 0xC60CD9B2UL, 0xB10BE924UL,
+	0x2F6F7C87UL, 0x58684C11UL, 0xC1611DABUL, 0xB6662D3DUL, 0x76DC4190UL, 0x01DB7106UL,
+	0x98D220BCUL, 0xEFD5102AUL, 0x71B18589UL, 0x06B6B51FUL, 0x9FBFE4A5UL, 0xE8B8D433UL,
+	0x7807C9A2UL, 0x0F00F934UL, 0x9609A88EUL, 0xE10E9818UL, 0x7F6A0DBBUL, 0x086D3D2DUL,
+	0x91646C97UL, 0xE6635C01UL, 0x6B6B51F4UL, 0x1C6C6162UL, 0x856530D8UL, 0xF262004EUL,
+	0x6C0695EDUL, 0x1B01A57BUL, 0x8208F4C1UL, 0xF50FC457UL, 0x65B0D9C6UL, 0x12B7E950UL,
+	0x8BBEB8EAUL, 0xFCB9887CUL, 0x62DD1DDFUL, 0x15DA2D49UL, 0x8CD37CF3UL, 0xFBD44C65UL,
+	0x4DB26158UL, 0x3AB551CEUL, 0xA3BC0074UL, 0xD4BB30E2UL, 0x4ADFA541UL, 0x3DD895D7UL,
+	0xA4D1C46DUL, 0xD3D6F4FBUL, 0x4369E96AUL, 0x346ED9FCUL, 0xAD678846UL, 0xDA60B8D0UL,
+	0x44042D73UL, 0x33031DE5UL, 0xAA0A4C5FUL, 0xDD0D7CC9UL, 0x5005713CUL, 0x270241AAUL,
+	0xBE0B1010UL, 0xC90C2086UL, 0x5768B525UL, 0x206F85B3UL, 0xB966D409UL, 0xCE61E49FUL,
+	0x5EDEF90EUL, 0x29D9C998UL, 0xB0D09822UL, 0xC7D7A8B4UL, 0x59B33D17UL, 0x2EB40D81UL,
+	0xB7BD5C3BUL, 0xC0BA6CADUL, 0xEDB88320UL, 0x9ABFB3B6UL, 0x03B6E20CUL, 0x74B1D29AUL,
+	0xEAD54739UL, 0x9DD277AFUL, 0x04DB2615UL, 0x73DC1683UL, 0xE3630B12UL, 0x94643B84UL,
+	0x0D6D6A3EUL, 0x7A6A5AA8UL, 0xE40ECF0BUL, 0x9309FF9DUL, 0x0A00AE27UL, 0x7D079EB1UL,
+	0xF00F9344UL, 0x8708A3D2UL, 0x1E01F268UL, 0x6906C2FEUL, 0xF762575DUL, 0x806567CBUL,
+	0x196C3671UL, 0x6E6B06E7UL, 0xFED41B76UL, 0x89D32BE0UL, 0x10DA7A5AUL, 0x67DD4ACCUL,
+	0xF9B9DF6FUL, 0x8EBEEFF9UL, 0x17B7BE43UL, 0x60B08ED5UL, 0xD6D6A3E8UL, 0xA1D1937EUL,
+	0x38D8C2C4UL, 0x4FDFF252UL, 0xD1BB67F1UL, 0xA6BC5767UL, 0x3FB506DDUL, 0x48B2364BUL,
+	0xD80D2BDAUL, 0xAF0A1B4CUL, 0x36034AF6UL, 0x41047A60UL, 0xDF60EFC3UL, 0xA867DF55UL,
+	0x316E8EEFUL, 0x4669BE79UL, 0xCB61B38CUL, 0xBC66831AUL, 0x256FD2A0UL, 0x5268E236UL,
+	0xCC0C7795UL, 0xBB0B4703UL, 0x220216B9UL, 0x5505262FUL, 0xC5BA3BBEUL, 0xB2BD0B28UL,
+	0x2BB45A92UL, 0x5CB36A04UL, 0xC2D7FFA7UL, 0xB5D0CF31UL, 0x2CD99E8BUL, 0x5BDEAE1DUL,
+	0x9B64C2B0UL, 0xEC63F226UL, 0x756AA39CUL, 0x026D930AUL, 0x9C0906A9UL, 0xEB0E363FUL,
+	0x72076785UL, 0x05005713UL, 0x95BF4A82UL, 0xE2B87A14UL, 0x7BB12BAEUL, 0x0CB61B38UL,
+	0x92D28E9BUL, 0xE5D5BE0DUL, 0x7CDCEFB7UL, 0x0BDBDF21UL, 0x86D3D2D4UL, 0xF1D4E242UL,
+	0x68DDB3F8UL, 0x1FDA836EUL, 0x81BE16CDUL, 0xF6B9265BUL, 0x6FB077E1UL, 0x18B74777UL,
+	0x88085AE6UL, 0xFF0F6A70UL, 0x66063BCAUL, 0x11010B5CUL, 0x8F659EFFUL, 0xF862AE69UL,
+	0x616BFFD3UL, 0x166CCF45UL, 0xA00AE278UL, 0xD70DD2EEUL, 0x4E048354UL, 0x3903B3C2UL,
+	0xA7672661UL, 0xD06016F7UL, 0x4969474DUL, 0x3E6E77DBUL, 0xAED16A4AUL, 0xD9D65ADCUL,
+	0x40DF0B66UL, 0x37D83BF0UL, 0xA9BCAE53UL, 0xDEBB9EC5UL, 0x47B2CF7FUL, 0x30B5FFE9UL,
+	0xBDBDF21CUL, 0xCABAC28AUL, 0x53B39330UL, 0x24B4A3A6UL, 0xBAD03605UL, 0xCDD70693UL,
+	0x54DE5729UL, 0x23D967BFUL, 0xB3667A2EUL, 0xC4614AB8UL, 0x5D681B02UL, 0x2A6F2B94UL,
+	0xB40BBE37UL, 0xC30C8EA1UL, 0x5A05DF1BUL, 0x2D02EF8DUL
+};
+
+
+
+/*
+ * Internal (Static) function to continue a CRC-32 over a block of bytes
+ * Start with 0xFFFFFFFF and complement the final value
+*/
+static unsigned long morse_updateFrameCrc(unsigned long crc, const char *data, int dataLen);
+
+
+
+/*
+ * Internal (Static) function to write bitCount bits of value, most significant
+ * First, with bit stuffing. Returns the number of characters written
+*/
+static int morse_putFrameBits(char *output, unsigned long value, int bitCount);
+
+
+
+/*
+ * Internal (Static) function to read bitCount bit stuffed bits at *position
+ * Returns MORSE_FRAME_FIELD_OK, MORSE_FRAME_FIELD_MORE or MORSE_FRAME_FIELD_BAD
+*/
+static int morse_getFrameBits(const char *input, int inputLen, int *position,
+								int bitCount, unsigned long *value);
+
+
+
+/*
+ * Internal (Static) function to check payloadLen characters as binary segments
+ * Returns the number of characters before the first invalid one, which is
+ * payloadLen if all are fine. The payload may still end inside a segment
+*/
+static int morse_checkFramePayload(const char *payload, int payloadLen);
+
+
+
+/*
+ * Internal (Static) function to check a complete payload, all segments whole
+ * Returns 1 for a valid payload, 0 otherwise
+*/
+static int morse_isFramePayload(const char *payload, int payloadLen);
+
+
+
+
+
+
+
+
+
+
+
+static unsigned long morse_updateFrameCrc(unsigned long crc, const char *data, int dataLen) {
+
+	register int dataIndex;
+
+	for (dataIndex = 0; dataIndex < dataLen; dataIndex++) {
+		crc = crcTable[(crc ^ (unsigned char) data[dataIndex]) & 0xFF] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+
+
+
+
+static int morse_putFrameBits(char *output, unsigned long value, int bitCount) {
+
+	register int bitIndex;
+	int outputCounter, onesRun;
+
+	outputCounter = 0;
+	onesRun = 0;
+
+	for (bitIndex = bitCount - 1; bitIndex >= 0; bitIndex--) {
+
+		if (((value >> bitIndex) & 1) != 0) {
+			output[outputCounter++] = '1';
+			onesRun = onesRun + 1;
+		} else {
+			output[outputCounter++] = '0';
+			onesRun = 0;
+		}
+
+		if (onesRun == MORSE_FRAME_STUFF_ONES) {
+			output[outputCounter++] = '0';
+			onesRun = 0;
+		}
+	}
+
+	return outputCounter;
+}
+
+
+
+
+static int morse_getFrameBits(const char *input, int inputLen, int *position,
+								int bitCount, unsigned long *value)
+{
+
+	register int bitIndex;
+	int inputIndex, onesRun;
+	unsigned long fieldValue;
+
+	inputIndex = *position;
+	onesRun = 0;
+	fieldValue = 0;
+
+	for (bitIndex = 0; bitIndex < bitCount; bitIndex++) {
+
+		if (inputIndex >= inputLen) return MORSE_FRAME_FIELD_MORE;
+
+		if (input[inputIndex] == '1') {
+			fieldValue = (fieldValue << 1) | 1;
+			onesRun = onesRun + 1;
+		} else if (input[inputIndex] == '0') {
+			fieldValue = fieldValue << 1;
+			onesRun = 0;
+		} else {
+			return MORSE_FRAME_FIELD_BAD;
+		}
+		inputIndex = inputIndex + 1;
+
+
+		/* After three '1' the encoder always put a stuffed '0', drop it */
+		if (onesRun == MORSE_FRAME_STUFF_ONES) {
+			if (inputIndex >= inputLen) return MORSE_FRAME_FIELD_MORE;
+			if (input[inputIndex] != '0') return MORSE_FRAME_FIELD_BAD;
+			inputIndex = inputIndex + 1;
+			onesRun = 0;
+		}
+	}
+
+	*position = inputIndex;
+	*value = fieldValue;
+
+	return MORSE_FRAME_FIELD_OK;
+}
+
+
+
+
+static int morse_checkFramePayload(const char *payload, int payloadLen) {
+
+	register int payloadIndex;
+	int onesRun;
+
+	onesRun = 0;
+
+	for (payloadIndex = 0; payloadIndex < payloadLen; payloadIndex++) {
+
+		if (payload[payloadIndex] == '0') {
+			onesRun = 0;
+		} else if (payload[payloadIndex] == '1' && onesRun < MORSE_FRAME_STUFF_ONES) {
+			onesRun = onesRun + 1;
+		} else {
+			return payloadIndex;
+		}
+	}
+
+
+	return payloadLen;
+}
+
+
+
+
+static int morse_isFramePayload(const char *payload, int payloadLen) {
+
+	if (morse_checkFramePayload(payload, payloadLen) != payloadLen) return 0;
+
+
+	/* A payload holds whole segments only, so it must end with a '0' */
+	return payloadLen == 0 || payload[payloadLen - 1] == '0';
+}
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL FRAMING FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_encodeBinaryFrame(unsigned int sequence, char *binaryPayload, int payloadLen,
+								char *framedOutput, int *framedLen)
+{
+
+	register int syncIndex;
+	int outputCounter;
+	unsigned long crc;
+	char headerBytes[4];
+
+	if (payloadLen < 0 || payloadLen > MORSE_FRAME_MAX_PAYLOAD) return -1;
+	if (morse_isFramePayload((const char*) binaryPayload, payloadLen) == 0) return -1;
+
+	sequence = sequence & 0xFFFF;
+	headerBytes[0] = (char) (sequence >> 8);
+	headerBytes[1] = (char) (sequence & 0xFF);
+	headerBytes[2] = (char) (payloadLen >> 8);
+	headerBytes[3] = (char) (payloadLen & 0xFF);
+
+	crc = morse_updateFrameCrc(0xFFFFFFFFUL, (const char*) headerBytes, 4);
+	crc = morse_updateFrameCrc(crc, (const char*) binaryPayload, payloadLen);
+	crc = (crc ^ 0xFFFFFFFFUL) & 0xFFFFFFFFUL;
+
+
+	outputCounter = 0;
+	for (syncIndex = 0; syncIndex < MORSE_FRAME_SYNC_ONES; syncIndex++)
+		framedOutput[outputCounter++] = '1';
+	framedOutput[outputCounter++] = '0';
+
+	outputCounter += morse_putFrameBits(framedOutput + outputCounter,
+								((unsigned long) sequence << 16) | (unsigned long) payloadLen, 32);
+
+	memcpy((void*) (framedOutput + outputCounter), (const void*) binaryPayload, payloadLen);
+	outputCounter += payloadLen;
+
+	outputCounter += morse_putFrameBits(framedOutput + outputCounter, crc, 32);
+
+	*framedLen = outputCounter;
+
+	return 0;
+}
+
+
+
+
+int morse_encodeBinaryFrames(char *binaryInputString, int binarySequenceLen, int maxPayloadLen,
+								unsigned int firstSequence, char *framedOutput, int *framedLen,
+								int *frameCount)
+{
+
+	register int globalInputIndex;
+	int globalOutputCounter, frameCounter;
+	int windowLen, payloadLen, frameLen;
+
+	if (maxPayloadLen > MORSE_FRAME_MAX_PAYLOAD) maxPayloadLen = MORSE_FRAME_MAX_PAYLOAD;
+	if (maxPayloadLen < 4) return -1;
+
+	globalInputIndex = 0;
+	globalOutputCounter = 0;
+	frameCounter = 0;
+
+	while (globalInputIndex < binarySequenceLen) {
+
+
+		/* Cut the frame after the last whole segment which fits into the payload */
+		windowLen = binarySequenceLen - globalInputIndex;
+		if (windowLen > maxPayloadLen) windowLen = maxPayloadLen;
+
+		payloadLen = windowLen;
+		while (payloadLen > 0 && binaryInputString[globalInputIndex + payloadLen - 1] != '0')
+			payloadLen = payloadLen - 1;
+
+		if (payloadLen == 0) return -1;
+
+		if (morse_encodeBinaryFrame(firstSequence + frameCounter,
+								binaryInputString + globalInputIndex, payloadLen,
+								framedOutput + globalOutputCounter, &frameLen) == -1) return -1;
+
+		globalInputIndex += payloadLen;
+		globalOutputCounter += frameLen;
+		frameCounter = frameCounter + 1;
+	}
+
+	*framedLen = globalOutputCounter;
+	*frameCount = frameCounter;
+
+	return 0;
+}
+
+
+
+
+void morse_initFrameDecoder(MorseFrameDecoder *decoder, unsigned int firstSequence) {
+
+	decoder->nextSequence = firstSequence & 0xFFFF;
+	decoder->streamPosition = 0;
+	decoder->lostStart = 0;
+	decoder->goodFrames = 0;
+	decoder->badFrames = 0;
+}
+
+
+
+
+int morse_decodeBinaryFrames(MorseFrameDecoder *decoder, char *framedInput, int framedLen,
+								int isLastInput, MorseFrameEvent *events, int maxEvents,
+								int *eventCount, int *consumed)
+{
+
+	register int globalInputIndex;
+	int onesRun, frameStart, position, payloadStart, fieldResult;
+	int eventCounter, scanEnd;
+	unsigned long header, frameCrc, crc;
+	unsigned int sequence, payloadLen, sequenceGap;
+	char headerBytes[4];
+	MorseFrameEvent *event;
+
+	if (maxEvents < 2) return -1;
+
+	globalInputIndex = 0;
+	onesRun = 0;
+	eventCounter = 0;
+	frameCrc = 0;
+	sequence = 0;
+	payloadLen = 0;
+	payloadStart = 0;
+
+	while (globalInputIndex < framedLen) {
+
+
+		/* Scan forward for the next SYNC, a run of six '1' closed by a '0' */
+		if (framedInput[globalInputIndex] == '1') {
+			onesRun = onesRun + 1;
+			globalInputIndex = globalInputIndex + 1;
+			continue;
+		}
+		if (framedInput[globalInputIndex] != '0' || onesRun < MORSE_FRAME_SYNC_ONES) {
+			onesRun = 0;
+			globalInputIndex = globalInputIndex + 1;
+			continue;
+		}
+
+		onesRun = 0;
+		frameStart = globalInputIndex - MORSE_FRAME_SYNC_ONES;
+		position = globalInputIndex + 1;
+
+
+		/* One good frame may need two events, stop here and let the caller come back */
+		if (eventCounter + 2 > maxEvents) {
+			globalInputIndex = frameStart;
+			break;
+		}
+
+
+		/* Header, payload and CRC. Whenever the input ends inside the frame, */
+		/* Either wait for more input or (at the end) let the scan finish */
+		fieldResult = morse_getFrameBits((const char*) framedInput, framedLen, &position, 32, &header);
+		if (fieldResult == MORSE_FRAME_FIELD_OK) {
+
+			sequence = (unsigned int) (header >> 16) & 0xFFFF;
+			payloadLen = (unsigned int) header & 0xFFFF;
+			payloadStart = position;
+
+			if (payloadLen > (unsigned int) MORSE_FRAME_MAX_PAYLOAD) {
+				fieldResult = MORSE_FRAME_FIELD_BAD;
+			} else if ((unsigned int) (framedLen - payloadStart) < payloadLen) {
+
+				/* Even a partial payload shows a damaged frame early */
+				if (morse_checkFramePayload((const char*) framedInput + payloadStart,
+								framedLen - payloadStart) < framedLen - payloadStart)
+					fieldResult = MORSE_FRAME_FIELD_BAD;
+				else
+					fieldResult = MORSE_FRAME_FIELD_MORE;
+			} else if (morse_isFramePayload((const char*) framedInput + payloadStart,
+								(int) payloadLen) == 0) {
+				fieldResult = MORSE_FRAME_FIELD_BAD;
+			} else {
+				position = payloadStart + payloadLen;
+				fieldResult = morse_getFrameBits((const char*) framedInput, framedLen,
+								&position, 32, &frameCrc);
+			}
+		}
+
+		if (fieldResult == MORSE_FRAME_FIELD_MORE) {
+			if (isLastInput == 0) {
+				globalInputIndex = frameStart;
+				break;
+			}
+			fieldResult = MORSE_FRAME_FIELD_BAD;
+		}
+
+		if (fieldResult == MORSE_FRAME_FIELD_OK) {
+
+			headerBytes[0] = (char) (sequence >> 8);
+			headerBytes[1] = (char) (sequence & 0xFF);
+			headerBytes[2] = (char) (payloadLen >> 8);
+			headerBytes[3] = (char) (payloadLen & 0xFF);
+
+			crc = morse_updateFrameCrc(0xFFFFFFFFUL, (const char*) headerBytes, 4);
+			crc = morse_updateFrameCrc(crc, (const char*) framedInput + payloadStart, (int) payloadLen);
+			crc = (crc ^ 0xFFFFFFFFUL) & 0xFFFFFFFFUL;
+
+			if (crc != frameCrc) fieldResult = MORSE_FRAME_FIELD_BAD;
+		}
+
+
+		/* A damaged frame is skipped by scanning on right behind its SYNC */
+		/* Nothing before that point is ever looked at again */
+		if (fieldResult == MORSE_FRAME_FIELD_BAD) {
+			decoder->badFrames++;
+			globalInputIndex = globalInputIndex + 1;
+			continue;
+		}
+
+
+		/* Report what was lost since the previous good frame: the discarded input, */
+		/* And the sequence numbers skipped over. An older sequence is a retransmission */
+		sequenceGap = (sequence - decoder->nextSequence) & 0xFFFF;
+		if (sequenceGap >= 0x8000) sequenceGap = 0;
+
+		if (sequenceGap > 0 || decoder->streamPosition + frameStart > decoder->lostStart) {
+			event = events + eventCounter++;
+			event->type = MORSE_FRAME_LOST;
+			event->sequence = decoder->nextSequence;
+			event->frameCount = sequenceGap;
+			event->streamOffset = decoder->lostStart;
+			event->length = decoder->streamPosition + frameStart - decoder->lostStart;
+			event->payload = 0;
+		}
+
+		event = events + eventCounter++;
+		event->type = MORSE_FRAME_GOOD;
+		event->sequence = sequence;
+		event->frameCount = 1;
+		event->streamOffset = decoder->streamPosition + payloadStart;
+		event->length = (long) payloadLen;
+		event->payload = (const char*) framedInput + payloadStart;
+
+		if (sequenceGap > 0 || sequence == decoder->nextSequence)
+			decoder->nextSequence = (sequence + 1) & 0xFFFF;
+		decoder->lostStart = decoder->streamPosition + position;
+		decoder->goodFrames++;
+
+		globalInputIndex = position;
+	}
+
+
+	/* Keep back a trailing run of '1', it may be the start of the next SYNC */
+	if (globalInputIndex >= framedLen) {
+		globalInputIndex = framedLen;
+		if (isLastInput == 0) globalInputIndex -= onesRun;
+	}
+	scanEnd = globalInputIndex;
+
+
+	/* At the end of the stream, whatever follows the last good frame is lost */
+	if (isLastInput == 1 && scanEnd == framedLen
+					&& decoder->streamPosition + framedLen > decoder->lostStart
+					&& eventCounter < maxEvents)
+	{
+		event = events + eventCounter++;
+		event->type = MORSE_FRAME_LOST;
+		event->sequence = decoder->nextSequence;
+		event->frameCount = 0;
+		event->streamOffset = decoder->lostStart;
+		event->length = decoder->streamPosition + framedLen - decoder->lostStart;
+		event->payload = 0;
+		decoder->lostStart = decoder->streamPosition + framedLen;
+	}
+
+	decoder->streamPosition += scanEnd;
+	*eventCount = eventCounter;
+	*consumed = scanEnd;
+
+	return 0;
+}
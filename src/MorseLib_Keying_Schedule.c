@@ -0,0 +1,243 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Keying Schedule Generator
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <limits.h>
+#include "MorseLib.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+/*
+ *
+ * Packed morse letter of each ASCII character, see MorseLib_Symbol_Table.c
+ * 0x00 means no morse code, 0x01 means word separator (SPACE)
+ *
+*/
+extern const unsigned char morse_asciiToCode[128];
+
+
+
+/*
+ *
+ * Internal (Static) function to get the packed morse letter of an ASCII character
+ * Returns 0 if the character has no morse code
+ *
+*/
+static unsigned int morse_keyingCode(char asciiChar);
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL KEYING FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+static unsigned int morse_keyingCode(char asciiChar) {
+
+	unsigned char index;
+
+	index = (unsigned char) asciiChar;
+	return index < 128 ? morse_asciiToCode[index] : 0;
+}
+
+
+
+
+int morse_initKeyer(MorseKeyer *keyer, int wpm, int farnsworthWpm) {
+
+	double unitTime, spacingTime;
+	unsigned int code, length, dashCount;
+	register int asciiIndex;
+
+
+	/* Without a speed, every duration is counted in dot units */
+	/* With a speed, the PARIS standard word of 50 units gives 1200000 / wpm us per unit */
+	if (wpm <= 0) {
+		unitTime = 1.0;
+	} else {
+		unitTime = 1200000.0 / wpm;
+	}
+
+	keyer->dotTime = (long) (unitTime + 0.5);
+	keyer->dashTime = (long) (3 * unitTime + 0.5);
+	keyer->elementGap = keyer->dotTime;
+	keyer->letterGap = (long) (3 * unitTime + 0.5);
+	keyer->wordGap = (long) (7 * unitTime + 0.5);
+
+
+	/* Farnsworth timing: letters are sent at wpm, but the letter and word gaps */
+	/* Are stretched so that the overall speed becomes farnsworthWpm */
+	/* The 19 gap units of PARIS take (60 * wpm - 37.2 * fwpm) / (wpm * fwpm) seconds */
+	if (wpm > 0 && farnsworthWpm > 0 && farnsworthWpm < wpm) {
+
+		spacingTime = 1000000.0 * (60.0 * wpm - 37.2 * farnsworthWpm)
+										/ ((double) wpm * farnsworthWpm);
+		keyer->letterGap = (long) (3 * spacingTime / 19 + 0.5);
+		keyer->wordGap = (long) (7 * spacingTime / 19 + 0.5);
+	}
+	else if (farnsworthWpm < 0 || (wpm <= 0 && farnsworthWpm > 0)) {
+		return -1;
+	}
+
+
+	/* Timing template of every character: its key-down elements plus the */
+	/* Gaps inside the letter, without any gap before or after the letter */
+	for (asciiIndex = 0; asciiIndex < 128; asciiIndex++) {
+
+		code = morse_asciiToCode[asciiIndex];
+		if (code <= 1) {
+			keyer->charTime[asciiIndex] = code == 1 ? 0 : -1;
+			continue;
+		}
+
+		length = 0;
+		dashCount = 0;
+		while (code > 1) {
+			dashCount += code & 1;
+			length = length + 1;
+			code = code >> 1;
+		}
+
+		keyer->charTime[asciiIndex] = dashCount * keyer->dashTime
+									+ (length - dashCount) * keyer->dotTime
+									+ (length - 1) * keyer->elementGap;
+	}
+
+	return 0;
+}
+
+
+
+
+int morse_convAsciiToKeying(MorseKeyer *keyer, char *AsciiInputString, int AsciiStringLen,
+								long *keyingOutput, int *keyingLen)
+{
+
+	register int globalInputIndex;
+	register int globalOutputCounter;
+	unsigned int code, elementMask;
+	unsigned int previousIsLetter, isFirstElement;
+	long pendingGap;
+
+	globalInputIndex = 0;
+	globalOutputCounter = 0;
+	previousIsLetter = 0;
+	pendingGap = 0;
+
+	while (globalInputIndex < AsciiStringLen) {
+
+		code = morse_keyingCode(*(AsciiInputString + globalInputIndex));
+		globalInputIndex = globalInputIndex + 1;
+
+		if (code == 0) return -1;
+
+
+		/* A SPACE adds one word gap, and replaces the letter gap around it */
+		/* A long run of them at a slow speed may not fit one key-up entry */
+		if (code == 1) {
+			if (pendingGap > LONG_MAX - keyer->wordGap) return -1;
+			pendingGap += keyer->wordGap;
+			previousIsLetter = 0;
+			continue;
+		}
+
+		if (previousIsLetter == 1) pendingGap += keyer->letterGap;
+
+
+		/* Walk the dash bits below the sentinel, most significant first */
+		/* Gaps are only collected, and written right before the next key-down */
+		/* So that consecutive gaps always come out as one single key-up run */
+		elementMask = 1;
+		while ((elementMask << 1) <= code) elementMask = elementMask << 1;
+
+		isFirstElement = 1;
+		for (elementMask = elementMask >> 1; elementMask != 0; elementMask = elementMask >> 1) {
+
+			if (isFirstElement == 0) pendingGap += keyer->elementGap;
+			if (pendingGap > 0) {
+				*(keyingOutput + globalOutputCounter++) = -pendingGap;
+				pendingGap = 0;
+			}
+
+			*(keyingOutput + globalOutputCounter++) =
+								(code & elementMask) != 0 ? keyer->dashTime : keyer->dotTime;
+			isFirstElement = 0;
+		}
+
+		previousIsLetter = 1;
+	}
+
+
+	/* Trailing SPACE characters leave a final key-up run */
+	if (pendingGap > 0) *(keyingOutput + globalOutputCounter++) = -pendingGap;
+
+	*keyingLen = globalOutputCounter;
+
+	return 0;
+}
+
+
+
+
+int morse_getKeyingAirtime(MorseKeyer *keyer, char *AsciiInputString, int AsciiStringLen,
+								double *airtime)
+{
+
+	register int globalInputIndex;
+	unsigned int code, previousIsLetter;
+	double totalTime;
+
+	totalTime = 0;
+	previousIsLetter = 0;
+
+	for (globalInputIndex = 0; globalInputIndex < AsciiStringLen; globalInputIndex++) {
+
+		code = morse_keyingCode(*(AsciiInputString + globalInputIndex));
+
+		if (code == 0) return -1;
+
+		if (code == 1) {
+			totalTime += keyer->wordGap;
+			previousIsLetter = 0;
+		} else {
+			if (previousIsLetter == 1) totalTime += keyer->letterGap;
+			totalTime += keyer->charTime[(unsigned char) *(AsciiInputString + globalInputIndex)];
+			previousIsLetter = 1;
+		}
+	}
+
+	*airtime = totalTime;
+
+	return 0;
+}
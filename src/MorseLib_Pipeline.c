@@ -0,0 +1,779 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Staged Pipeline
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "MorseLib_Pipeline.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+/*
+ * Ring indices are published with release stores and read with acquire loads
+ * So the bytes written before a store are visible to the thread that loads it
+*/
+#define RING_LOAD(location) __atomic_load_n(&(location), __ATOMIC_ACQUIRE)
+#define RING_STORE(location, value) __atomic_store_n(&(location), (value), __ATOMIC_RELEASE)
+#define PIPELINE_IDLE_ROUNDS 64				/* Empty rounds a worker yields before it sleeps */
+
+
+
+/*
+ * Everything a worker thread needs, one per thread
+ * Scratch buffers give a stage one linear view of ring data that wraps around
+*/
+typedef struct MorsePipelineWorker_ {
+
+	MorsePipeline *pipeline;
+	int workerIndex;
+	pthread_t thread;
+	char *inputScratch;
+	char *outputScratch;
+
+} MorsePipelineWorker;
+
+
+
+/*
+ *
+ * Internal (Static) function to run one stage once
+ * Returns 1 if the stage moved any data or finished, 0 if it could not
+ *
+*/
+static int morse_runStage(MorsePipelineWorker *worker, int stageIndex);
+
+
+
+/*
+ *
+ * Internal (Static) thread function, runs the stages assigned to one worker
+ * Until all of them are finished or some stage failed
+ *
+*/
+static void *morse_pipelineWorker(void *workerArgument);
+
+
+
+/*
+ *
+ * Internal (Static) function to give the first workerCount scratch buffer pairs
+ * And the worker array back to the allocator of the pipeline
+ *
+*/
+static void morse_releaseWorkers(MorsePipeline *pipeline, int workerCount);
+
+
+
+/*
+ *
+ * Internal (Static) functions to report an event which may let a stage go on
+ * (Waking the sleeping workers), and to sleep until the event count moves away
+ * From seenEvents or some stage failed
+ *
+*/
+static void morse_signalPipeline(MorsePipeline *pipeline);
+
+static void morse_waitPipeline(MorsePipeline *pipeline, unsigned int seenEvents);
+
+
+
+/*
+ *
+ * Internal (Static) function to copy between linear memory and a ring region
+ * Which may wrap around the end of the ring buffer
+ *
+*/
+static void morse_copyFromRing(MorseRing *ring, unsigned int position, char *data, int dataLen);
+
+static void morse_copyToRing(MorseRing *ring, unsigned int position, const char *data, int dataLen);
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	RING BUFFER FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_initRing(MorseRing *ring, int capacity) {
+
+	return morse_initRingWith(ring, capacity, &morse_defaultAllocator);
+}
+
+
+
+
+int morse_initRingWith(MorseRing *ring, int capacity, const MorseAllocator *allocator) {
+
+	unsigned int roundedCapacity;
+
+	roundedCapacity = 1;
+	while (roundedCapacity < (unsigned int) capacity) roundedCapacity = roundedCapacity << 1;
+
+	memset((void*) ring, 0, sizeof(MorseRing));
+	ring->buffer = (char*) allocator->allocate(allocator->userData, roundedCapacity);
+	if (ring->buffer == 0) return -1;
+
+	ring->capacityMask = roundedCapacity - 1;
+	ring->allocator = allocator;
+
+	return 0;
+}
+
+
+
+
+void morse_destroyRing(MorseRing *ring) {
+
+	if (ring->buffer != 0) ring->allocator->release(ring->allocator->userData, (void*) ring->buffer);
+	ring->buffer = 0;
+}
+
+
+
+
+static void morse_copyFromRing(MorseRing *ring, unsigned int position, char *data, int dataLen) {
+
+	unsigned int offset, firstPart;
+
+	offset = position & ring->capacityMask;
+	firstPart = ring->capacityMask + 1 - offset;
+	if (firstPart > (unsigned int) dataLen) firstPart = dataLen;
+
+	memcpy((void*) data, (const void*) (ring->buffer + offset), firstPart);
+	memcpy((void*) (data + firstPart), (const void*) ring->buffer, dataLen - firstPart);
+}
+
+
+
+
+static void morse_copyToRing(MorseRing *ring, unsigned int position, const char *data, int dataLen) {
+
+	unsigned int offset, firstPart;
+
+	offset = position & ring->capacityMask;
+	firstPart = ring->capacityMask + 1 - offset;
+	if (firstPart > (unsigned int) dataLen) firstPart = dataLen;
+
+	memcpy((void*) (ring->buffer + offset), (const void*) data, firstPart);
+	memcpy((void*) ring->buffer, (const void*) (data + firstPart), dataLen - firstPart);
+}
+
+
+
+
+int morse_writeRing(MorseRing *ring, const char *data, int dataLen) {
+
+	unsigned int head, tail, room;
+
+	head = RING_LOAD(ring->head);
+	tail = ring->tail;
+	room = ring->capacityMask + 1 - (tail - head);
+	if ((unsigned int) dataLen > room) dataLen = room;
+
+	morse_copyToRing(ring, tail, data, dataLen);
+	RING_STORE(ring->tail, tail + dataLen);
+
+	return dataLen;
+}
+
+
+
+
+int morse_readRing(MorseRing *ring, char *data, int maxLen) {
+
+	unsigned int head, tail;
+
+	tail = RING_LOAD(ring->tail);
+	head = ring->head;
+	if ((unsigned int) maxLen > tail - head) maxLen = tail - head;
+
+	morse_copyFromRing(ring, head, data, maxLen);
+	RING_STORE(ring->head, head + maxLen);
+
+	return maxLen;
+}
+
+
+
+
+int morse_getRingOccupancy(MorseRing *ring) {
+
+	return (int) (RING_LOAD(ring->tail) - RING_LOAD(ring->head));
+}
+
+
+
+
+void morse_closeRing(MorseRing *ring) {
+
+	RING_STORE(ring->isClosed, 1);
+}
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	PIPELINE FUNCTION IMPLEMENTATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_createPipeline(MorsePipeline *pipeline, int stageCount, int ringCapacity) {
+
+	return morse_createPipelineWith(pipeline, stageCount, ringCapacity, &morse_defaultAllocator);
+}
+
+
+
+
+int morse_createPipelineWith(MorsePipeline *pipeline, int stageCount, int ringCapacity,
+								const MorseAllocator *allocator)
+{
+
+	register int ringIndex;
+
+	if (stageCount <= 0 || ringCapacity <= 0) return -1;
+
+	memset((void*) pipeline, 0, sizeof(MorsePipeline));
+	pipeline->failedStage = -1;
+	pipeline->stageCount = stageCount;
+	pipeline->allocator = allocator;
+	pthread_mutex_init(&pipeline->idleLock, 0);
+	pthread_cond_init(&pipeline->idleWake, 0);
+	pipeline->stages = (MorsePipelineStage*) allocator->allocate(allocator->userData,
+											stageCount * sizeof(MorsePipelineStage));
+	pipeline->rings = (MorseRing*) allocator->allocate(allocator->userData,
+											(stageCount + 1) * sizeof(MorseRing));
+
+	if (pipeline->stages == 0 || pipeline->rings == 0) goto FAILURE;
+
+	memset((void*) pipeline->stages, 0, stageCount * sizeof(MorsePipelineStage));
+	memset((void*) pipeline->rings, 0, (stageCount + 1) * sizeof(MorseRing));
+	for (ringIndex = 0; ringIndex <= stageCount; ringIndex++) {
+		if (morse_initRingWith(pipeline->rings + ringIndex, ringCapacity, allocator) == -1)
+			goto FAILURE;
+	}
+
+	return 0;
+
+FAILURE:
+	morse_destroyPipeline(pipeline);
+	return -1;
+}
+
+
+
+
+void morse_setPipelineStage(MorsePipeline *pipeline, int stageIndex,
+							MorseStageFunction process, void *stageState)
+{
+
+	if (stageIndex < 0 || stageIndex >= pipeline->stageCount) return;
+
+	pipeline->stages[stageIndex].process = process;
+	pipeline->stages[stageIndex].stageState = stageState;
+}
+
+
+
+
+static int morse_runStage(MorsePipelineWorker *worker, int stageIndex) {
+
+	MorsePipeline *pipeline;
+	MorsePipelineStage *stage;
+	MorseRing *inputRing, *outputRing;
+	unsigned int inputHead, inputTail, outputHead, outputTail, capacity, occupancy;
+	int isClosed, isLastInput, available, room, consumed, produced;
+	char *inputView, *outputView;
+
+	pipeline = worker->pipeline;
+	stage = pipeline->stages + stageIndex;
+	inputRing = pipeline->rings + stageIndex;
+	outputRing = pipeline->rings + stageIndex + 1;
+	capacity = inputRing->capacityMask + 1;
+
+
+	/* Closed flag first: once it is seen, the tail loaded after it is final */
+	isClosed = RING_LOAD(inputRing->isClosed);
+	inputTail = RING_LOAD(inputRing->tail);
+	inputHead = inputRing->head;
+	outputHead = RING_LOAD(outputRing->head);
+	outputTail = outputRing->tail;
+
+	occupancy = inputTail - inputHead;
+	available = (int) occupancy;
+	room = (int) (capacity - (outputTail - outputHead));
+
+	stage->metrics.queueSamples++;
+	stage->metrics.queueOccupancySum += occupancy;
+	if (occupancy > stage->metrics.queueHighWater) stage->metrics.queueHighWater = occupancy;
+
+	if (available == 0 && isClosed == 0) {
+		stage->metrics.inputStalls++;
+		return 0;
+	}
+	if (room == 0) {
+		stage->metrics.outputStalls++;
+		return 0;
+	}
+
+
+	/* Hand the stage linear memory, use scratch space only if a region wraps */
+	if ((inputHead & inputRing->capacityMask) + available > capacity) {
+		morse_copyFromRing(inputRing, inputHead, worker->inputScratch, available);
+		inputView = worker->inputScratch;
+	} else {
+		inputView = inputRing->buffer + (inputHead & inputRing->capacityMask);
+	}
+
+	if ((outputTail & outputRing->capacityMask) + room > capacity) {
+		outputView = worker->outputScratch;
+	} else {
+		outputView = outputRing->buffer + (outputTail & outputRing->capacityMask);
+	}
+
+	isLastInput = isClosed;
+	consumed = produced = 0;
+
+	if (stage->process(stage->stageState, (const char*) inputView, available, isLastInput,
+						outputView, room, &consumed, &produced) == -1) {
+		__atomic_store_n(&pipeline->failedStage, stageIndex, __ATOMIC_RELEASE);
+		return 1;
+	}
+
+	if (outputView == worker->outputScratch)
+		morse_copyToRing(outputRing, outputTail, (const char*) outputView, produced);
+
+	RING_STORE(inputRing->head, inputHead + consumed);
+	RING_STORE(outputRing->tail, outputTail + produced);
+
+	if (consumed > 0 || produced > 0) {
+		stage->metrics.invocations++;
+		stage->metrics.bytesIn += consumed;
+		stage->metrics.bytesOut += produced;
+	}
+	else if (room < available) {
+		stage->metrics.outputStalls++;
+	}
+
+
+	/* All input is gone and the stage had nothing left to flush: we are done */
+	if (isLastInput == 1 && consumed == available && produced == 0) {
+		stage->isFinished = 1;
+		morse_closeRing(outputRing);
+		return 1;
+	}
+
+	return consumed > 0 || produced > 0;
+}
+
+
+
+
+static void *morse_pipelineWorker(void *workerArgument) {
+
+	MorsePipelineWorker *worker;
+	MorsePipeline *pipeline;
+	register int stageIndex;
+	int hasProgress, hasOpenStage, idleRounds;
+	unsigned int seenEvents;
+
+	worker = (MorsePipelineWorker*) workerArgument;
+	pipeline = worker->pipeline;
+	idleRounds = 0;
+
+	do {
+		hasProgress = 0;
+		hasOpenStage = 0;
+		seenEvents = __atomic_load_n(&pipeline->eventCount, __ATOMIC_SEQ_CST);
+
+
+		/* Round robin over the stages of this worker, stage i belongs to i % threads */
+		for (stageIndex = worker->workerIndex; stageIndex < pipeline->stageCount;
+											stageIndex += pipeline->threadCount) {
+
+			if (pipeline->stages[stageIndex].isFinished == 1) continue;
+
+			hasOpenStage = 1;
+			hasProgress |= morse_runStage(worker, stageIndex);
+		}
+
+		if (__atomic_load_n(&pipeline->failedStage, __ATOMIC_ACQUIRE) != -1) {
+			morse_signalPipeline(pipeline);
+			break;
+		}
+
+
+		/* Short stalls are bridged by yielding, longer ones (a slow live source) */
+		/* Sleep until something happens anywhere in the pipeline */
+		if (hasProgress == 1) {
+			morse_signalPipeline(pipeline);
+			idleRounds = 0;
+		}
+		else if (hasOpenStage == 1 && ++idleRounds < PIPELINE_IDLE_ROUNDS) {
+			sched_yield();
+		}
+		else if (hasOpenStage == 1) {
+			morse_waitPipeline(pipeline, seenEvents);
+			idleRounds = 0;
+		}
+
+	} while (hasOpenStage == 1);
+
+	return 0;
+}
+
+
+
+
+static void morse_signalPipeline(MorsePipeline *pipeline) {
+
+	/* Sequentially consistent: either the waiter sees the new count, or this */
+	/* Thread sees the waiter and broadcasts under the lock it waits with */
+	__atomic_add_fetch(&pipeline->eventCount, 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&pipeline->sleeperCount, __ATOMIC_SEQ_CST) == 0) return;
+
+	pthread_mutex_lock(&pipeline->idleLock);
+	pthread_cond_broadcast(&pipeline->idleWake);
+	pthread_mutex_unlock(&pipeline->idleLock);
+}
+
+
+
+
+static void morse_waitPipeline(MorsePipeline *pipeline, unsigned int seenEvents) {
+
+	pthread_mutex_lock(&pipeline->idleLock);
+	__atomic_add_fetch(&pipeline->sleeperCount, 1, __ATOMIC_SEQ_CST);
+
+	while (__atomic_load_n(&pipeline->eventCount, __ATOMIC_SEQ_CST) == seenEvents
+			&& __atomic_load_n(&pipeline->failedStage, __ATOMIC_ACQUIRE) == -1)
+		pthread_cond_wait(&pipeline->idleWake, &pipeline->idleLock);
+
+	__atomic_sub_fetch(&pipeline->sleeperCount, 1, __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&pipeline->idleLock);
+}
+
+
+
+
+int morse_startPipeline(MorsePipeline *pipeline, int threadCount) {
+
+	MorsePipelineWorker *workers;
+	register int workerIndex;
+	int capacity;
+	const MorseAllocator *allocator;
+
+	if (threadCount <= 0) return -1;
+	if (threadCount > pipeline->stageCount) threadCount = pipeline->stageCount;
+
+	allocator = pipeline->allocator;
+	capacity = pipeline->rings[0].capacityMask + 1;
+	workers = (MorsePipelineWorker*) allocator->allocate(allocator->userData,
+											threadCount * sizeof(MorsePipelineWorker));
+	if (workers == 0) return -1;
+	memset((void*) workers, 0, threadCount * sizeof(MorsePipelineWorker));
+
+	pipeline->threadCount = threadCount;
+	pipeline->threadStorage = (void*) workers;
+
+	for (workerIndex = 0; workerIndex < threadCount; workerIndex++) {
+		workers[workerIndex].pipeline = pipeline;
+		workers[workerIndex].workerIndex = workerIndex;
+		workers[workerIndex].inputScratch = (char*) allocator->allocate(allocator->userData, capacity);
+		workers[workerIndex].outputScratch = (char*) allocator->allocate(allocator->userData, capacity);
+		if (workers[workerIndex].inputScratch == 0 || workers[workerIndex].outputScratch == 0)
+			goto FAILURE;
+	}
+
+	for (workerIndex = 0; workerIndex < threadCount; workerIndex++) {
+		if (pthread_create(&workers[workerIndex].thread, 0,
+							morse_pipelineWorker, (void*) (workers + workerIndex)) != 0) {
+			pipeline->threadCount = workerIndex;
+			__atomic_store_n(&pipeline->failedStage, 0, __ATOMIC_RELEASE);
+			morse_signalPipeline(pipeline);
+			morse_joinPipeline(pipeline);
+			return -1;
+		}
+	}
+
+	return 0;
+
+FAILURE:
+	morse_releaseWorkers(pipeline, threadCount);
+	pipeline->threadStorage = 0;
+	pipeline->threadCount = 0;
+	return -1;
+}
+
+
+
+
+static void morse_releaseWorkers(MorsePipeline *pipeline, int workerCount) {
+
+	MorsePipelineWorker *workers;
+	const MorseAllocator *allocator;
+	register int workerIndex;
+
+	workers = (MorsePipelineWorker*) pipeline->threadStorage;
+	allocator = pipeline->allocator;
+
+	for (workerIndex = 0; workerIndex < workerCount; workerIndex++) {
+		if (workers[workerIndex].inputScratch != 0)
+			allocator->release(allocator->userData, (void*) workers[workerIndex].inputScratch);
+		if (workers[workerIndex].outputScratch != 0)
+			allocator->release(allocator->userData, (void*) workers[workerIndex].outputScratch);
+	}
+
+	allocator->release(allocator->userData, (void*) workers);
+}
+
+
+
+
+int morse_pushPipeline(MorsePipeline *pipeline, const char *data, int dataLen) {
+
+	int pushedLen;
+
+	pushedLen = morse_writeRing(pipeline->rings, data, dataLen);
+	if (pushedLen > 0) morse_signalPipeline(pipeline);
+
+	return pushedLen;
+}
+
+
+
+
+void morse_closePipeline(MorsePipeline *pipeline) {
+
+	morse_closeRing(pipeline->rings);
+	morse_signalPipeline(pipeline);
+}
+
+
+
+
+int morse_pullPipeline(MorsePipeline *pipeline, char *data, int maxLen) {
+
+	MorseRing *lastRing;
+	int isClosed, pulledLen;
+
+	lastRing = pipeline->rings + pipeline->stageCount;
+
+	isClosed = RING_LOAD(lastRing->isClosed);
+	pulledLen = morse_readRing(lastRing, data, maxLen);
+	if (pulledLen > 0) morse_signalPipeline(pipeline);
+
+	if (pulledLen == 0
+		&& (isClosed == 1 || __atomic_load_n(&pipeline->failedStage, __ATOMIC_ACQUIRE) != -1))
+		return -1;
+
+	return pulledLen;
+}
+
+
+
+
+int morse_joinPipeline(MorsePipeline *pipeline) {
+
+	MorsePipelineWorker *workers;
+	register int workerIndex;
+
+	workers = (MorsePipelineWorker*) pipeline->threadStorage;
+	if (workers == 0) return pipeline->failedStage == -1 ? 0 : -1;
+
+	for (workerIndex = 0; workerIndex < pipeline->threadCount; workerIndex++) {
+		pthread_join(workers[workerIndex].thread, 0);
+	}
+
+	morse_releaseWorkers(pipeline, pipeline->threadCount);
+	pipeline->threadStorage = 0;
+
+	return pipeline->failedStage == -1 ? 0 : -1;
+}
+
+
+
+
+void morse_destroyPipeline(MorsePipeline *pipeline) {
+
+	register int ringIndex;
+
+	if (pipeline->rings != 0) {
+		for (ringIndex = 0; ringIndex <= pipeline->stageCount; ringIndex++)
+			morse_destroyRing(pipeline->rings + ringIndex);
+	}
+
+	if (pipeline->rings != 0)
+		pipeline->allocator->release(pipeline->allocator->userData, (void*) pipeline->rings);
+	if (pipeline->stages != 0)
+		pipeline->allocator->release(pipeline->allocator->userData, (void*) pipeline->stages);
+	pipeline->rings = 0;
+	pipeline->stages = 0;
+
+	pthread_cond_destroy(&pipeline->idleWake);
+	pthread_mutex_destroy(&pipeline->idleLock);
+}
+
+
+
+
+int morse_getStageMetrics(MorsePipeline *pipeline, int stageIndex, MorseStageMetrics *metrics) {
+
+	if (stageIndex < 0 || stageIndex >= pipeline->stageCount) return -1;
+
+	memcpy((void*) metrics, (const void*) &pipeline->stages[stageIndex].metrics,
+											sizeof(MorseStageMetrics));
+	return 0;
+}
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	READY MADE STAGE IMPLEMENTATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_stageBinaryToMorse(void *stageState, const char *input, int inputLen,
+							int isLastInput, char *output, int outputRoom,
+							int *consumed, int *produced)
+{
+
+	register int inputIndex;
+	int segmentCount, cutIndex, onesCount;
+
+
+	/* Every '0' closes one segment, which becomes one morse character */
+	/* Take whole segments only, and no more than fit into the output room */
+	/* A fourth '1' in a row fails right away once the segments before it are out */
+	segmentCount = 0;
+	cutIndex = 0;
+	onesCount = 0;
+	for (inputIndex = 0; inputIndex < inputLen && segmentCount < outputRoom; inputIndex++) {
+		if (input[inputIndex] == '0') {
+			segmentCount = segmentCount + 1;
+			cutIndex = inputIndex + 1;
+			onesCount = 0;
+		}
+		else if (++onesCount > 3) {
+			if (cutIndex == 0) return -1;
+			break;
+		}
+	}
+
+
+	/* An unfinished segment at the very end of the input is an error */
+	if (isLastInput == 1 && cutIndex < inputLen && segmentCount < outputRoom) return -1;
+
+	*consumed = cutIndex;
+	*produced = 0;
+	if (cutIndex == 0) return 0;
+
+	return morse_convBinaryToMorse((BisTree*) stageState, (char*) input, cutIndex, output, produced);
+}
+
+
+
+
+int morse_stageMorseToAscii(void *stageState, const char *input, int inputLen,
+							int isLastInput, char *output, int outputRoom,
+							int *consumed, int *produced)
+{
+
+	register int inputIndex;
+	int outputCount, cutIndex, letterLen;
+
+
+	/* A letter may be cut right before any separator, and after any separator */
+	/* A letter gives one ASCII character, and each word separator one SPACE */
+	outputCount = 0;
+	cutIndex = 0;
+	letterLen = 0;
+	for (inputIndex = 0; inputIndex < inputLen; inputIndex++) {
+
+		/* A letter longer than any code fails right away once the letters before it are out */
+		if (input[inputIndex] != MORSE_LETTER_SEPARATOR && input[inputIndex] != MORSE_WORD_SEPARATOR) {
+			letterLen = letterLen + 1;
+			if (letterLen <= MORSE_STAGE_MAX_LETTER) continue;
+			if (cutIndex == 0) return -1;
+			break;
+		}
+
+		if (letterLen > 0) {
+			if (outputCount == outputRoom) break;
+			outputCount = outputCount + 1;
+			letterLen = 0;
+			cutIndex = inputIndex;
+		}
+		if (input[inputIndex] == MORSE_WORD_SEPARATOR) {
+			if (outputCount == outputRoom) break;
+			outputCount = outputCount + 1;
+		}
+		cutIndex = inputIndex + 1;
+	}
+
+
+	/* At the end of the input the trailing letter needs no separator */
+	if (isLastInput == 1 && inputIndex == inputLen && letterLen > 0 && outputCount < outputRoom)
+		cutIndex = inputLen;
+
+	*consumed = cutIndex;
+	*produced = 0;
+	if (cutIndex == 0) return 0;
+
+	return morse_convMorseToAscii((BisTree*) stageState, (char*) input, cutIndex, output, produced);
+}
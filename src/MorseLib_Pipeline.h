@@ -0,0 +1,264 @@
+
+
+/************************************************************************************
+	Program Interface of Morse Library Staged Pipeline
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef MORSELIB_PIPELINE_H
+#define MORSELIB_PIPELINE_H
+
+
+
+
+
+
+
+#include <pthread.h>
+#include "MorseLib.h"
+
+
+
+/*
+ * A pipeline chains several processing stages, eg. tone detection, then
+ * Binary-To-Morse, then Morse-To-ASCII. Neighbouring stages are connected by
+ * Bounded lock-free single producer / single consumer ring buffers
+ *
+ * Each stage runs on its own thread, or several stages share one thread of a
+ * Small pool. A stage which finds its output ring full simply stops consuming,
+ * So backpressure travels upstream until morse_pushPipeline() accepts less data
+ * A thread whose stages found nothing to do for a while sleeps on a condition
+ * Variable, until a push, pull, close or the progress of another stage wakes it
+ *
+ * Needs POSIX threads, link with -lpthread
+*/
+
+
+
+
+
+/*
+ * Lock-free single producer / single consumer byte ring
+ * head is only written by the consumer, tail only by the producer, both keep
+ * Counting up and wrap around naturally. They live on separate cache lines
+*/
+
+typedef struct MorseRing_ {
+
+	char *buffer;
+	unsigned int capacityMask;				/* Capacity - 1, capacity is power of 2 */
+	int isClosed;							/* Producer will not write any more */
+	const MorseAllocator *allocator;
+
+	unsigned int head;
+	char headPadding[60];
+	unsigned int tail;
+	char tailPadding[60];
+
+} MorseRing;
+
+
+
+/*
+	Ring buffer functions, usable on their own as well
+	morse_initRing() rounds capacity up to a power of 2, morse_initRingWith()
+	Takes the buffer from the given allocator
+	Returns 0 for success, -1 for memory allocation failure
+
+	morse_writeRing() / morse_readRing() never block, they return the number
+	Of bytes actually written / read, which may be less than requested
+*/
+
+int morse_initRing(MorseRing *ring, int capacity);
+
+int morse_initRingWith(MorseRing *ring, int capacity, const MorseAllocator *allocator);
+
+void morse_destroyRing(MorseRing *ring);
+
+int morse_writeRing(MorseRing *ring, const char *data, int dataLen);
+
+int morse_readRing(MorseRing *ring, char *data, int maxLen);
+
+int morse_getRingOccupancy(MorseRing *ring);
+
+void morse_closeRing(MorseRing *ring);
+
+
+
+
+
+
+
+/*
+ * A pipeline stage function
+ *
+ *	in:
+ *		void *stageState		- State pointer given to morse_setPipelineStage()
+ *		const char *input		- Readable input bytes
+ *		int inputLen			- Number of readable input bytes
+ *		int isLastInput			- 1 if no more input will ever follow this
+ *		char *output			- Writable output space
+ *		int outputRoom			- Size of the output space
+ *	out:
+ *		int *consumed			- Input bytes used up, the rest is offered again
+ *		int *produced			- Output bytes written
+ *
+ *	Returns 0 for success, -1 to stop the whole pipeline with an error
+*/
+
+typedef int (*MorseStageFunction)(void *stageState, const char *input, int inputLen,
+							int isLastInput, char *output, int outputRoom,
+							int *consumed, int *produced);
+
+
+
+/*
+ * Per stage metrics, written only by the thread running the stage
+ * They are exact after morse_joinPipeline(), approximate while running
+*/
+
+typedef struct MorseStageMetrics_ {
+
+	unsigned long invocations;				/* Calls which moved some data */
+	unsigned long bytesIn;
+	unsigned long bytesOut;
+	unsigned long inputStalls;				/* Nothing to read */
+	unsigned long outputStalls;				/* No room to write (backpressure) */
+	unsigned long queueSamples;
+	unsigned long queueOccupancySum;		/* Input ring occupancy summed per sample */
+	unsigned int queueHighWater;			/* Highest input ring occupancy seen */
+
+} MorseStageMetrics;
+
+
+
+typedef struct MorsePipelineStage_ {
+
+	MorseStageFunction process;
+	void *stageState;
+	int isFinished;
+	MorseStageMetrics metrics;
+
+} MorsePipelineStage;
+
+
+
+typedef struct MorsePipeline_ {
+
+	int stageCount;
+	MorsePipelineStage *stages;
+	MorseRing *rings;						/* stageCount + 1 rings, stage i reads ring i */
+
+	int threadCount;
+	void *threadStorage;
+	int failedStage;						/* -1 while no stage has failed */
+
+	unsigned int eventCount;				/* Counts pushes, pulls, closes and stage progress */
+	int sleeperCount;						/* Idle workers waiting on idleWake */
+	pthread_mutex_t idleLock;
+	pthread_cond_t idleWake;
+
+	const MorseAllocator *allocator;		/* Stages, rings and worker scratch */
+
+} MorsePipeline;
+
+
+
+/*
+	Create a pipeline of stageCount stages with rings of ringCapacity bytes
+	morse_createPipelineWith() takes the stages, the rings and the worker scratch
+	Buffers of morse_startPipeline() from the given allocator
+	Returns 0 for success, -1 for memory allocation failure
+	One must call morse_destroyPipeline() after being done with the pipeline
+*/
+
+int morse_createPipeline(MorsePipeline *pipeline, int stageCount, int ringCapacity);
+
+int morse_createPipelineWith(MorsePipeline *pipeline, int stageCount, int ringCapacity,
+								const MorseAllocator *allocator);
+
+void morse_setPipelineStage(MorsePipeline *pipeline, int stageIndex,
+							MorseStageFunction process, void *stageState);
+
+
+
+/*
+	Start the stages on threadCount threads
+	With threadCount equal to the stage count, every stage gets its own thread
+	With fewer threads, stage i is multiplexed onto thread (i % threadCount)
+
+	Returns 0 for success, -1 if threads could not be started
+*/
+
+int morse_startPipeline(MorsePipeline *pipeline, int threadCount);
+
+
+
+/*
+	Feed input into the first stage, and take output from the last stage
+	Both never block and return the number of bytes moved
+	morse_closePipeline() marks the end of input
+
+	morse_pullPipeline() returns -1 once the pipeline is finished and drained,
+	or failed (see failedStage)
+*/
+
+int morse_pushPipeline(MorsePipeline *pipeline, const char *data, int dataLen);
+
+void morse_closePipeline(MorsePipeline *pipeline);
+
+int morse_pullPipeline(MorsePipeline *pipeline, char *data, int maxLen);
+
+
+
+/*
+	Wait for all threads to finish, returns 0 if every stage succeeded, -1 otherwise
+*/
+
+int morse_joinPipeline(MorsePipeline *pipeline);
+
+void morse_destroyPipeline(MorsePipeline *pipeline);
+
+int morse_getStageMetrics(MorsePipeline *pipeline, int stageIndex, MorseStageMetrics *metrics);
+
+
+
+
+
+/*
+ * Ready made stages, stageState is the BisTree dictionary of the conversion
+ * They hold back an unfinished letter (or binary segment) until its separator
+ * Arrives, so input may be split anywhere
+ *
+ *	morse_stageBinaryToMorse	- state from morse_createBinaryToMorseMapping()
+ *	morse_stageMorseToAscii		- state from morse_createMorseToAsciiMapping()
+ *
+ * A run of more than 3 '1' (the longest segment is 1110) or a letter of more than
+ * MORSE_STAGE_MAX_LETTER elements can never be completed, the stage fails as soon
+ * As it sees one, instead of waiting for a separator
+*/
+
+#define MORSE_STAGE_MAX_LETTER 6				/* Longest code of the morse mapping */
+
+int morse_stageBinaryToMorse(void *stageState, const char *input, int inputLen,
+							int isLastInput, char *output, int outputRoom,
+							int *consumed, int *produced);
+
+int morse_stageMorseToAscii(void *stageState, const char *input, int inputLen,
+							int isLastInput, char *output, int outputRoom,
+							int *consumed, int *produced);
+
+
+
+
+
+
+
+#endif
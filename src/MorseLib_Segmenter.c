@@ -0,0 +1,701 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Letter Segmentation
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "MorseLib_Segmenter.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+/*
+ *
+ * Packed morse letter of each ASCII character and the reverse table,
+ * See MorseLib_Symbol_Table.c
+ *
+*/
+extern const unsigned char morse_asciiToCode[128];
+
+extern const char morse_codeToAscii[128];
+
+
+
+#define MORSE_SEGMENT_MAX_LETTER 6				/* Longest letter of the symbol table */
+#define MORSE_SEGMENT_MAX_BEAM 32
+#define MORSE_SEGMENT_WORD_BONUS 8.0			/* Log likelihood bonus of a listed word */
+
+
+
+/* One partial reading in the beam of a position of the word */
+typedef struct MorseSegmentState_ {
+
+	float score;
+	short previousPosition;
+	unsigned char previousRank;
+	unsigned char letter;					/* Alphabet index of the last letter */
+
+} MorseSegmentState;
+
+
+
+/* One word of a whole conversion, shared by the worker threads */
+typedef struct MorseSegmentSpan_ {
+
+	int start;
+	int length;
+	int readingLen;
+
+} MorseSegmentSpan;
+
+typedef struct MorseSegmentJob_ {
+
+	const MorseSegmenter *segmenter;
+	char *morseInputString;
+	char *AsciiOutputString;
+	MorseSegmentSpan *spans;
+	int spanCount;
+	int nextSpan;
+	int isFailed;
+
+} MorseSegmentJob;
+
+
+
+/*
+ *
+ * Internal (Static) function to hash a sequence of elements (0 DOT, 1 DASH)
+ *
+*/
+static unsigned long morse_hashElements(const unsigned char *elements, int elementCount);
+
+
+
+/*
+ *
+ * Internal (Static) function to expand a word of the list into its elements
+ * And to mark the element positions where its letters end
+ * Returns the number of elements, -1 if the word does not fit
+ *
+*/
+static int morse_expandWord(const char *word, int wordLen,
+								unsigned char *elements, unsigned char *letterEnds);
+
+
+
+/*
+ *
+ * Internal (Static) function, log likelihood of a word under the bigram model
+ *
+*/
+static double morse_scoreWord(const MorseSegmenter *segmenter, const char *word, int wordLen);
+
+
+
+/*
+ *
+ * Internal (Static) function to add a reading to a list sorted by score
+ * A reading already in the list keeps the better of both scores
+ *
+*/
+static void morse_addReading(MorseReading *readings, int *readingCount, int maxReadings,
+								const char *text, int textLen, double score, int isDictionaryWord);
+
+
+
+/*
+ *
+ * Internal (Static) worker function, segments words until none is left
+ *
+*/
+static void *morse_segmentWorker(void *workerArgument);
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+static unsigned long morse_hashElements(const unsigned char *elements, int elementCount) {
+
+	register int elementIndex;
+	unsigned long hash;
+
+	hash = 2166136261UL;
+	for (elementIndex = 0; elementIndex < elementCount; elementIndex++) {
+		hash = ((hash ^ (elements[elementIndex] + 1)) * 16777619UL) & 0xFFFFFFFFUL;
+	}
+
+	return hash;
+}
+
+
+
+
+static int morse_expandWord(const char *word, int wordLen,
+								unsigned char *elements, unsigned char *letterEnds)
+{
+
+	register int letterIndex;
+	int elementCount;
+	unsigned int code, elementMask;
+	unsigned char asciiIndex;
+
+	elementCount = 0;
+	memset((void*) letterEnds, 0, MORSE_SEGMENT_MAX_ELEMENTS + 1);
+
+	for (letterIndex = 0; letterIndex < wordLen; letterIndex++) {
+
+		asciiIndex = (unsigned char) word[letterIndex];
+		code = asciiIndex < 128 ? morse_asciiToCode[asciiIndex] : 0;
+		if (code <= 1) return -1;
+
+		elementMask = 1;
+		while ((elementMask << 1) <= code) elementMask = elementMask << 1;
+
+		for (elementMask = elementMask >> 1; elementMask != 0; elementMask = elementMask >> 1) {
+			if (elementCount == MORSE_SEGMENT_MAX_ELEMENTS) return -1;
+			elements[elementCount++] = (unsigned char) ((code & elementMask) != 0);
+		}
+
+		letterEnds[elementCount] = 1;
+	}
+
+	return elementCount;
+}
+
+
+
+
+static double morse_scoreWord(const MorseSegmenter *segmenter, const char *word, int wordLen) {
+
+	register int letterIndex;
+	int previous, current;
+	double score;
+
+	score = 0.0;
+	previous = segmenter->alphabetSize;
+
+	for (letterIndex = 0; letterIndex < wordLen; letterIndex++) {
+		current = segmenter->alphabetIndex[(unsigned char) word[letterIndex]];
+		score += segmenter->bigram[previous][current];
+		previous = current;
+	}
+
+	return score + segmenter->bigram[previous][segmenter->alphabetSize];
+}
+
+
+
+
+static void morse_addReading(MorseReading *readings, int *readingCount, int maxReadings,
+								const char *text, int textLen, double score, int isDictionaryWord)
+{
+
+	register int readingIndex;
+	MorseReading newReading;
+
+	for (readingIndex = 0; readingIndex < *readingCount; readingIndex++) {
+
+		if (readings[readingIndex].length != textLen
+			|| memcmp((const void*) readings[readingIndex].text, (const void*) text, textLen) != 0)
+			continue;
+
+
+		/* Same text found again, take it out and put it back with the better score */
+		if (readings[readingIndex].score >= score) return;
+		isDictionaryWord |= readings[readingIndex].isDictionaryWord;
+		memmove((void*) (readings + readingIndex), (const void*) (readings + readingIndex + 1),
+						(*readingCount - readingIndex - 1) * sizeof(MorseReading));
+		*readingCount = *readingCount - 1;
+		break;
+	}
+
+	if (*readingCount == maxReadings && readings[maxReadings - 1].score >= score) return;
+
+	memcpy((void*) newReading.text, (const void*) text, textLen);
+	newReading.text[textLen] = '\0';
+	newReading.length = textLen;
+	newReading.score = score;
+	newReading.isDictionaryWord = isDictionaryWord;
+
+	readingIndex = *readingCount < maxReadings ? *readingCount : maxReadings - 1;
+	while (readingIndex > 0 && readings[readingIndex - 1].score < score) {
+		readings[readingIndex] = readings[readingIndex - 1];
+		readingIndex = readingIndex - 1;
+	}
+	readings[readingIndex] = newReading;
+
+	if (*readingCount < maxReadings) *readingCount = *readingCount + 1;
+}
+
+
+
+
+static void *morse_segmentWorker(void *workerArgument) {
+
+	MorseSegmentJob *job;
+	MorseSegmentSpan *span;
+	MorseReading reading;
+	int spanIndex, readingCount;
+
+	job = (MorseSegmentJob*) workerArgument;
+
+	while (1) {
+
+		spanIndex = __atomic_fetch_add(&job->nextSpan, 1, __ATOMIC_RELAXED);
+		if (spanIndex >= job->spanCount) break;
+		if (__atomic_load_n(&job->isFailed, __ATOMIC_RELAXED) != 0) break;
+
+		span = job->spans + spanIndex;
+		if (morse_segmentMorseWord(job->segmenter, job->morseInputString + span->start,
+								span->length, 1, &reading, &readingCount) == -1)
+		{
+			__atomic_store_n(&job->isFailed, 1, __ATOMIC_RELAXED);
+			break;
+		}
+
+
+		/* A reading is never longer than its morse word, so it is parked at the */
+		/* Position of the word itself, and moved into place after all threads are done */
+		memcpy((void*) (job->AsciiOutputString + span->start), (const void*) reading.text,
+															reading.length);
+		span->readingLen = reading.length;
+	}
+
+	return 0;
+}
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL SEGMENTER FUNCTION IMPLEMENTATIONS	/////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_createSegmenter(MorseSegmenter *segmenter, char **wordList, int wordCount) {
+
+	return morse_createSegmenterWith(segmenter, wordList, wordCount, &morse_defaultAllocator);
+}
+
+
+
+
+int morse_createSegmenterWith(MorseSegmenter *segmenter, char **wordList, int wordCount,
+								const MorseAllocator *allocator)
+{
+
+	register int wordIndex, letterIndex;
+	int alphabetSize, wordLen, textLen, previous, current, elementCount;
+	unsigned int capacity, slot;
+	unsigned long patternHash;
+	double bigramCount[MORSE_SEGMENT_ALPHABET + 1][MORSE_SEGMENT_ALPHABET + 1];
+	double rowTotal, highestCount;
+	unsigned char elements[MORSE_SEGMENT_MAX_ELEMENTS], letterEnds[MORSE_SEGMENT_MAX_ELEMENTS + 1];
+	char word[MORSE_SEGMENT_MAX_ELEMENTS];
+	char *memorySpace;
+	MorseSegmenterEntry *entry;
+
+
+	/* The alphabet is every character of the symbol table, except SPACE */
+	alphabetSize = 0;
+	for (letterIndex = 0; letterIndex < 128; letterIndex++) {
+		segmenter->alphabetIndex[letterIndex] = -1;
+		if (morse_asciiToCode[letterIndex] > 1 && alphabetSize < MORSE_SEGMENT_ALPHABET) {
+			segmenter->alphabet[alphabetSize] = (char) letterIndex;
+			segmenter->alphabetIndex[letterIndex] = (signed char) alphabetSize++;
+		}
+	}
+	segmenter->alphabetSize = alphabetSize;
+
+
+	/* Room for the hash table at half load and for the text of all words */
+	capacity = 16;
+	while (capacity < 2 * (unsigned int) wordCount) capacity = capacity << 1;
+
+	textLen = 0;
+	for (wordIndex = 0; wordIndex < wordCount; wordIndex++) {
+		wordLen = strlen(wordList[wordIndex]);
+		textLen += wordLen < MORSE_SEGMENT_MAX_ELEMENTS ? wordLen : 0;
+	}
+
+	memorySpace = (char*) allocator->allocate(allocator->userData,
+								capacity * sizeof(MorseSegmenterEntry) + textLen + 1);
+	if (memorySpace == 0) return -1;
+
+	segmenter->allocator = allocator;
+	segmenter->tableMask = capacity - 1;
+	segmenter->table = (MorseSegmenterEntry*) memorySpace;
+	segmenter->wordText = memorySpace + capacity * sizeof(MorseSegmenterEntry);
+	memset((void*) segmenter->table, 0, capacity * sizeof(MorseSegmenterEntry));
+	memset((void*) bigramCount, 0, sizeof(bigramCount));
+
+
+	textLen = 0;
+	for (wordIndex = 0; wordIndex < wordCount; wordIndex++) {
+
+
+		/* Take the word in upper case, skip it if any letter has no morse code */
+		wordLen = strlen(wordList[wordIndex]);
+		if (wordLen == 0 || wordLen >= MORSE_SEGMENT_MAX_ELEMENTS) continue;
+
+		for (letterIndex = 0; letterIndex < wordLen; letterIndex++) {
+			word[letterIndex] = wordList[wordIndex][letterIndex];
+			if (word[letterIndex] >= 'a' && word[letterIndex] <= 'z')
+				word[letterIndex] = (char) (word[letterIndex] - 'a' + 'A');
+		}
+
+		elementCount = morse_expandWord((const char*) word, wordLen, elements, letterEnds);
+		if (elementCount == -1) continue;
+
+
+		/* Letter bigrams of the word, with the word boundary on both sides */
+		previous = alphabetSize;
+		for (letterIndex = 0; letterIndex < wordLen; letterIndex++) {
+			current = segmenter->alphabetIndex[(unsigned char) word[letterIndex]];
+			bigramCount[previous][current] += 1.0;
+			previous = current;
+		}
+		bigramCount[previous][alphabetSize] += 1.0;
+
+
+		/* Insert into the hash table by its pattern, or count it once more */
+		patternHash = morse_hashElements((const unsigned char*) elements, elementCount);
+		slot = (unsigned int) patternHash & segmenter->tableMask;
+
+		while ((entry = segmenter->table + slot)->wordLen != 0) {
+			if (entry->patternHash == patternHash && entry->wordLen == wordLen
+				&& memcmp((const void*) (segmenter->wordText + entry->wordOffset),
+						  (const void*) word, wordLen) == 0) break;
+			slot = (slot + 1) & segmenter->tableMask;
+		}
+
+		if (entry->wordLen == 0) {
+			memcpy((void*) (segmenter->wordText + textLen), (const void*) word, wordLen);
+			entry->patternHash = patternHash;
+			entry->wordOffset = textLen;
+			entry->wordLen = wordLen;
+			textLen += wordLen;
+		}
+		entry->wordScore += 1.0f;
+	}
+
+
+	/* Word bonus: a fixed bonus plus the log frequency relative to the most frequent word */
+	highestCount = 1.0;
+	for (slot = 0; slot <= segmenter->tableMask; slot++) {
+		if (segmenter->table[slot].wordScore > highestCount)
+			highestCount = segmenter->table[slot].wordScore;
+	}
+	for (slot = 0; slot <= segmenter->tableMask; slot++) {
+		entry = segmenter->table + slot;
+		if (entry->wordLen != 0)
+			entry->wordScore = (float) (MORSE_SEGMENT_WORD_BONUS + log(entry->wordScore / highestCount));
+	}
+
+
+	/* Log probabilities with add-one smoothing, so unseen bigrams stay possible */
+	for (previous = 0; previous <= alphabetSize; previous++) {
+
+		rowTotal = 0.0;
+		for (current = 0; current <= alphabetSize; current++) rowTotal += bigramCount[previous][current];
+
+		for (current = 0; current <= alphabetSize; current++) {
+			segmenter->bigram[previous][current] =
+				(float) log((bigramCount[previous][current] + 1.0) / (rowTotal + alphabetSize + 1));
+		}
+	}
+
+	return 0;
+}
+
+
+
+
+void morse_destroySegmenter(MorseSegmenter *segmenter) {
+
+	const MorseAllocator *allocator;
+
+	allocator = segmenter->allocator;
+	allocator->release(allocator->userData, (void*) segmenter->table);
+	memset((void*) segmenter, 0, sizeof(MorseSegmenter));
+}
+
+
+
+
+int morse_segmentMorseWord(const MorseSegmenter *segmenter, char *morseWord, int morseWordLen,
+								int topK, MorseReading *readings, int *readingCount)
+{
+
+	register int position, rank;
+	int elementCount, letterLen, letterStart, beamSize, stateCount, insertIndex;
+	int alphabetSize, isValid, readingLen, wordCount;
+	unsigned int code, slot;
+	unsigned long patternHash;
+	char asciiChar, text[MORSE_SEGMENT_MAX_ELEMENTS + 1];
+	float score;
+	unsigned char elements[MORSE_SEGMENT_MAX_ELEMENTS];
+	unsigned char breakBefore[MORSE_SEGMENT_MAX_ELEMENTS + 1];
+	unsigned char letterEnds[MORSE_SEGMENT_MAX_ELEMENTS + 1];
+	unsigned char stateLen[MORSE_SEGMENT_MAX_ELEMENTS + 1];
+	MorseSegmentState states[MORSE_SEGMENT_MAX_ELEMENTS + 1][MORSE_SEGMENT_MAX_BEAM];
+	MorseSegmentState newState, *state;
+	const MorseSegmenterEntry *entry;
+
+	if (topK < 1) return -1;
+	if (topK > MORSE_SEGMENT_MAX_READINGS) topK = MORSE_SEGMENT_MAX_READINGS;
+
+	beamSize = 2 * topK;
+	alphabetSize = segmenter->alphabetSize;
+
+
+	/* Elements of the word, and where a surviving '/' forces a letter boundary */
+	elementCount = 0;
+	memset((void*) breakBefore, 0, sizeof(breakBefore));
+	for (position = 0; position < morseWordLen; position++) {
+
+		if (morseWord[position] == MORSE_LETTER_SEPARATOR) {
+			breakBefore[elementCount] = 1;
+			continue;
+		}
+		if (morseWord[position] != MORSE_DOT && morseWord[position] != MORSE_DASH) return -1;
+		if (elementCount == MORSE_SEGMENT_MAX_ELEMENTS) return -1;
+
+		elements[elementCount++] = (unsigned char) (morseWord[position] == MORSE_DASH);
+	}
+
+	*readingCount = 0;
+	if (elementCount == 0) {
+		morse_addReading(readings, readingCount, topK, "", 0, 0.0, 0);
+		return 0;
+	}
+
+
+	/* Dynamic programming over positions: the beam of position j holds the best */
+	/* Readings of the first j elements. A letter of length 1 to 6 ending at j */
+	/* Is read straight from the packed code table, growing the code bit by bit */
+	stateLen[0] = 1;
+	states[0][0].score = 0.0f;
+	states[0][0].letter = (unsigned char) alphabetSize;
+	states[0][0].previousPosition = -1;
+	states[0][0].previousRank = 0;
+
+	for (position = 1; position <= elementCount; position++) {
+
+		stateLen[position] = 0;
+		code = 1;
+
+		for (letterLen = 1; letterLen <= MORSE_SEGMENT_MAX_LETTER && letterLen <= position; letterLen++) {
+
+			letterStart = position - letterLen;
+			if (letterLen > 1 && breakBefore[letterStart + 1] == 1) break;
+
+
+			/* Prepend the element at letterStart, the code of letterStart .. position */
+			/* The old sentinel bit becomes the new first element, a new sentinel goes above */
+			code = (code ^ (1U << (letterLen - 1))) | (1U << letterLen)
+							| ((unsigned int) elements[letterStart] << (letterLen - 1));
+
+			asciiChar = morse_codeToAscii[code];
+			if (asciiChar == 0 || asciiChar == ' ') continue;
+
+			newState.letter = (unsigned char) segmenter->alphabetIndex[(unsigned char) asciiChar];
+			newState.previousPosition = (short) letterStart;
+
+			for (rank = 0; rank < stateLen[letterStart]; rank++) {
+
+				state = &states[letterStart][rank];
+				score = state->score + segmenter->bigram[state->letter][newState.letter];
+
+
+				/* Keep the beam sorted, drop the reading if it is not good enough */
+				stateCount = stateLen[position];
+				if (stateCount == beamSize && states[position][beamSize - 1].score >= score) break;
+
+				newState.score = score;
+				newState.previousRank = (unsigned char) rank;
+
+				insertIndex = stateCount < beamSize ? stateCount : beamSize - 1;
+				while (insertIndex > 0 && states[position][insertIndex - 1].score < score) {
+					states[position][insertIndex] = states[position][insertIndex - 1];
+					insertIndex = insertIndex - 1;
+				}
+				states[position][insertIndex] = newState;
+				if (stateCount < beamSize) stateLen[position] = (unsigned char) (stateCount + 1);
+			}
+		}
+	}
+
+
+	/* Close every complete reading with the word boundary, and spell it backwards */
+	for (rank = 0; rank < stateLen[elementCount]; rank++) {
+
+		state = &states[elementCount][rank];
+		score = state->score + segmenter->bigram[state->letter][alphabetSize];
+
+		readingLen = 0;
+		while (state->previousPosition >= 0) {
+			text[readingLen++] = segmenter->alphabet[state->letter];
+			state = &states[state->previousPosition][state->previousRank];
+		}
+		for (letterLen = 0; letterLen < readingLen / 2; letterLen++) {
+			asciiChar = text[letterLen];
+			text[letterLen] = text[readingLen - 1 - letterLen];
+			text[readingLen - 1 - letterLen] = asciiChar;
+		}
+
+		morse_addReading(readings, readingCount, topK, (const char*) text, readingLen, score, 0);
+	}
+
+
+	/* Words of the list with the same pattern, if their letters respect every '/' */
+	patternHash = morse_hashElements((const unsigned char*) elements, elementCount);
+	slot = (unsigned int) patternHash & segmenter->tableMask;
+	wordCount = 0;
+
+	while ((entry = segmenter->table + slot)->wordLen != 0 && wordCount <= (int) segmenter->tableMask) {
+
+		slot = (slot + 1) & segmenter->tableMask;
+		wordCount = wordCount + 1;
+		if (entry->patternHash != patternHash) continue;
+
+		if (morse_expandWord((const char*) segmenter->wordText + entry->wordOffset, entry->wordLen,
+							 (unsigned char*) text, letterEnds) != elementCount
+			|| memcmp((const void*) text, (const void*) elements, elementCount) != 0) continue;
+
+		isValid = 1;
+		for (position = 1; position < elementCount; position++) {
+			if (breakBefore[position] == 1 && letterEnds[position] == 0) isValid = 0;
+		}
+		if (isValid == 0) continue;
+
+		morse_addReading(readings, readingCount, topK,
+						 (const char*) segmenter->wordText + entry->wordOffset, entry->wordLen,
+						 morse_scoreWord(segmenter, segmenter->wordText + entry->wordOffset,
+										 entry->wordLen) + entry->wordScore, 1);
+	}
+
+	return 0;
+}
+
+
+
+
+int morse_convUnseparatedMorseToAscii(const MorseSegmenter *segmenter,
+								char *morseInputString, int morseStringLen, int threadCount,
+								char *AsciiOutputString, int *AsciiStringLen)
+{
+
+	register int globalInputIndex;
+	int spanIndex, globalOutputCounter, threadIndex, startedCount;
+	const MorseAllocator *allocator;
+	MorseSegmentJob job;
+	pthread_t *workers;
+
+
+	/* One span per word, words are separated by '|' */
+	job.spanCount = 1;
+	for (globalInputIndex = 0; globalInputIndex < morseStringLen; globalInputIndex++) {
+		if (morseInputString[globalInputIndex] == MORSE_WORD_SEPARATOR) job.spanCount++;
+	}
+
+	if (threadCount < 1) threadCount = 1;
+
+	allocator = segmenter->allocator;
+	workers = (pthread_t*) allocator->allocate(allocator->userData,
+								threadCount * sizeof(pthread_t)
+								+ job.spanCount * sizeof(MorseSegmentSpan));
+	if (workers == 0) return -1;
+	job.spans = (MorseSegmentSpan*) (workers + threadCount);
+
+	spanIndex = 0;
+	job.spans[0].start = 0;
+	for (globalInputIndex = 0; globalInputIndex < morseStringLen; globalInputIndex++) {
+		if (morseInputString[globalInputIndex] != MORSE_WORD_SEPARATOR) continue;
+		job.spans[spanIndex].length = globalInputIndex - job.spans[spanIndex].start;
+		job.spans[++spanIndex].start = globalInputIndex + 1;
+	}
+	job.spans[spanIndex].length = morseStringLen - job.spans[spanIndex].start;
+
+	job.segmenter = segmenter;
+	job.morseInputString = morseInputString;
+	job.AsciiOutputString = AsciiOutputString;
+	job.nextSpan = 0;
+	job.isFailed = 0;
+
+
+	/* The calling thread works along with the extra threads */
+	startedCount = 0;
+	for (threadIndex = 0; threadIndex < threadCount - 1; threadIndex++) {
+		if (pthread_create(workers + threadIndex, 0, morse_segmentWorker, (void*) &job) != 0) break;
+		startedCount = startedCount + 1;
+	}
+
+	morse_segmentWorker((void*) &job);
+
+	for (threadIndex = 0; threadIndex < startedCount; threadIndex++)
+		pthread_join(workers[threadIndex], 0);
+
+
+	/* Move the parked readings together, with a SPACE for every word separator */
+	globalOutputCounter = 0;
+	for (spanIndex = 0; job.isFailed == 0 && spanIndex < job.spanCount; spanIndex++) {
+
+		memmove((void*) (AsciiOutputString + globalOutputCounter),
+				(const void*) (AsciiOutputString + job.spans[spanIndex].start),
+				job.spans[spanIndex].readingLen);
+		globalOutputCounter += job.spans[spanIndex].readingLen;
+
+		if (spanIndex < job.spanCount - 1) AsciiOutputString[globalOutputCounter++] = ' ';
+	}
+
+	allocator->release(allocator->userData, (void*) workers);
+	*AsciiStringLen = globalOutputCounter;
+
+	return job.isFailed == 0 ? 0 : -1;
+}
@@ -0,0 +1,147 @@
+
+
+/************************************************************************************
+	Program Interface of Morse Library Letter Segmentation
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef MORSELIB_SEGMENTER_H
+#define MORSELIB_SEGMENTER_H
+
+
+
+
+
+
+
+#include "MorseLib.h"
+
+
+
+/*
+ * Decoding of morse code which lost its letter separators, eg. "...---..."
+ * Instead of ".../---/..." (SOS). Words are still separated by '|', and any
+ * Letter separator '/' which did survive is respected
+ *
+ * Every word is segmented into letters by dynamic programming over the positions
+ * Of the word. Letters come straight from the packed morse code table (the
+ * Dichotomic tree in heap order, 128 bytes), and each reading is scored by a
+ * Letter bigram model trained from a word list. Readings which are words of the
+ * List get a bonus, they are found by a hash of their separator-less pattern
+ * The search keeps only the best few readings per position (beam pruning)
+ *
+ * Needs POSIX threads and the math library, link with -lpthread -lm
+*/
+
+#define MORSE_SEGMENT_ALPHABET 64
+#define MORSE_SEGMENT_MAX_ELEMENTS 64			/* Dots and dashes in one word */
+#define MORSE_SEGMENT_MAX_READINGS 16
+
+
+
+typedef struct MorseSegmenterEntry_ {
+
+	unsigned long patternHash;
+	int wordOffset;
+	int wordLen;							/* 0 for an empty slot */
+	float wordScore;
+
+} MorseSegmenterEntry;
+
+
+
+typedef struct MorseSegmenter_ {
+
+	int alphabetSize;
+	char alphabet[MORSE_SEGMENT_ALPHABET];
+	signed char alphabetIndex[128];			/* -1 for characters without morse letter */
+
+	/* Log probability of a letter after a letter, index alphabetSize is the word boundary */
+	float bigram[MORSE_SEGMENT_ALPHABET + 1][MORSE_SEGMENT_ALPHABET + 1];
+
+	unsigned int tableMask;
+	MorseSegmenterEntry *table;				/* Open addressing, by pattern hash */
+	char *wordText;
+
+	const MorseAllocator *allocator;
+
+} MorseSegmenter;
+
+
+
+typedef struct MorseReading_ {
+
+	char text[MORSE_SEGMENT_MAX_ELEMENTS + 1];	/* NUL terminated */
+	int length;
+	double score;							/* Log likelihood, higher is better */
+	int isDictionaryWord;
+
+} MorseReading;
+
+
+
+/*
+	Build a segmenter from a word list, letters are taken case insensitive
+	Words repeated in the list count as more frequent, words with characters
+	without morse code are skipped
+
+	Returns 0 for success, -1 for memory allocation failure
+	One must call morse_destroySegmenter() after being done with the segmenter
+*/
+
+int morse_createSegmenter(MorseSegmenter *segmenter, char **wordList, int wordCount);
+
+int morse_createSegmenterWith(MorseSegmenter *segmenter, char **wordList, int wordCount,
+								const MorseAllocator *allocator);
+
+void morse_destroySegmenter(MorseSegmenter *segmenter);
+
+
+
+/*
+	Best readings of one word of morse code, dots, dashes and optional '/'
+
+	in:
+		int topK					- Number of readings wanted, at most MORSE_SEGMENT_MAX_READINGS
+	out:
+		MorseReading *readings		- Space for topK readings, best first
+		int *readingCount			- Number of readings written
+
+	Returns 0 for success, -1 for invalid input or a word too long
+*/
+
+int morse_segmentMorseWord(const MorseSegmenter *segmenter, char *morseWord, int morseWordLen,
+								int topK, MorseReading *readings, int *readingCount);
+
+
+
+/*
+	Convert morse code without letter separators to ASCII text, taking the best
+	Reading of every word. Words are processed in parallel on threadCount threads
+
+	out:
+		char *AsciiOutputString		- Pre-allocated space of at least morseStringLen
+									  characters. Will not contain NUL terminator (\0)
+		int *AsciiStringLen			- Length of ASCII character output
+
+	Returns 0 for successful conversion, -1 for failure
+*/
+
+int morse_convUnseparatedMorseToAscii(const MorseSegmenter *segmenter,
+								char *morseInputString, int morseStringLen, int threadCount,
+								char *AsciiOutputString, int *AsciiStringLen);
+
+
+
+
+
+
+
+#endif
@@ -0,0 +1,895 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Wideband CW Skimmer
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "MorseLib_Skimmer.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+/*
+ *
+ * ASCII character of each packed morse letter, see MorseLib_Symbol_Table.c
+ *
+*/
+extern const char morse_codeToAscii[128];
+
+
+
+#define MORSE_SKIMMER_PI 3.14159265358979323846
+#define MORSE_SKIMMER_FRAME_ITEM 8				/* Frames taken by a thread at once */
+#define MORSE_SKIMMER_BIN_ITEM 16				/* Bins taken by a thread at once */
+#define MORSE_SKIMMER_MAX_THREADS 64
+#define MORSE_SKIMMER_NO_LEVEL 1e30f			/* Trackers start at the first level seen */
+#define MORSE_SKIMMER_WARMUP 200				/* Frames of fast tracking, without signals */
+#define MORSE_SKIMMER_NOISE_FALL 0.02f			/* Noise floor steps, per frame, it settles */
+#define MORSE_SKIMMER_NOISE_RISE 0.005f			/* On the lowest fifth of the levels */
+#define MORSE_SKIMMER_PEAK_RISE 0.1f
+#define MORSE_SKIMMER_PEAK_FALL 0.005f
+
+#define MORSE_SKIMMER_PHASE_SPECTRA 0
+#define MORSE_SKIMMER_PHASE_KEYING 1
+#define MORSE_SKIMMER_PHASE_LETTERS 2
+#define MORSE_SKIMMER_PHASE_EXIT 3				/* Workers leave their loop */
+
+
+
+/*
+ *
+ * Internal (Static) function, in place radix-2 FFT of one interleaved complex frame
+ *
+*/
+static void morse_transformFrame(const MorseSkimmer *skimmer, float *frame);
+
+
+
+/*
+ *
+ * Internal (Static) functions of the three phases of a block
+ * Each one handles one item: MORSE_SKIMMER_FRAME_ITEM frames or MORSE_SKIMMER_BIN_ITEM bins
+ *
+*/
+static void morse_computeSpectra(MorseSkimmer *skimmer, int item, float *scratch);
+
+static void morse_computeKeying(MorseSkimmer *skimmer, int item);
+
+static void morse_classifyKeying(MorseSkimmer *skimmer, int item);
+
+
+
+/*
+ *
+ * Internal (Static) functions of the classifier of one bin
+ * A finished mark becomes an element once its gap is confirmed, a letter is
+ * Written to the ring when the gap grows to a letter gap
+ * A reset keeps the measured dot length, so a finished signal still reports
+ * Its speed until read. Only a new carrier starts over from the initial one
+ *
+*/
+static void morse_resetClassifier(MorseSkimmer *skimmer, MorseSkimmerChannel *channel);
+
+static void morse_commitMark(MorseSkimmer *skimmer, MorseSkimmerChannel *channel);
+
+static void morse_closeLetter(MorseSkimmer *skimmer, MorseSkimmerChannel *channel, int bin);
+
+static void morse_finishSignal(MorseSkimmer *skimmer, MorseSkimmerChannel *channel, int bin);
+
+
+
+/*
+ *
+ * Internal (Static) worker thread function, waits for a phase, runs its items and
+ * Reports back, until the exit phase. The function which runs the items of the
+ * Current phase until none is left, the one which runs a phase on all threads
+ * And the one which ends the worker threads
+ *
+*/
+static void *morse_skimmerWorker(void *skimmerArgument);
+
+static void morse_runSkimmerItems(MorseSkimmer *skimmer, float *scratch);
+
+static void morse_runSkimmerPhase(MorseSkimmer *skimmer, int phase, int itemCount);
+
+static void morse_stopSkimmerWorkers(MorseSkimmer *skimmer);
+
+
+
+/*
+ *
+ * Internal (Static) function to process the first frameCount frames waiting in
+ * The sample buffer, and to drop the samples no later frame needs
+ *
+*/
+static void morse_processSkimmerBlock(MorseSkimmer *skimmer, int frameCount);
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL SKIMMER FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_createSkimmer(MorseSkimmer *skimmer, double sampleRate, int fftSize,
+								int threadCount, int ringCapacity)
+{
+	return morse_createSkimmerWith(skimmer, sampleRate, fftSize, threadCount, ringCapacity,
+								&morse_defaultAllocator);
+}
+
+
+
+
+int morse_createSkimmerWith(MorseSkimmer *skimmer, double sampleRate, int fftSize,
+								int threadCount, int ringCapacity, const MorseAllocator *allocator)
+{
+
+	register int index;
+	int bits, reversed, value;
+	unsigned int capacity;
+	size_t floatCount, memorySize;
+	double frameRate;
+	char *memorySpace;
+
+	if (sampleRate <= 0 || fftSize < 16 || (fftSize & (fftSize - 1)) != 0 || ringCapacity <= 0)
+		return -1;
+	if (threadCount < 1) threadCount = 1;
+	if (threadCount > MORSE_SKIMMER_MAX_THREADS) threadCount = MORSE_SKIMMER_MAX_THREADS;
+
+	capacity = 1;
+	while (capacity < (unsigned int) ringCapacity) capacity = capacity << 1;
+
+	skimmer->sampleRate = sampleRate;
+	skimmer->fftSize = fftSize;
+	skimmer->hopSize = fftSize / 2;
+	skimmer->threadCount = threadCount;
+	skimmer->sampleCapacity = fftSize + (MORSE_SKIMMER_BLOCK_FRAMES - 1) * skimmer->hopSize;
+	skimmer->sampleCount = 0;
+	skimmer->frameCount = 0;
+	skimmer->framesSeen = 0;
+	skimmer->ringMask = capacity - 1;
+	skimmer->allocator = allocator;
+
+
+	/* One single allocation: pointer sized and channel parts first (alignment), */
+	/* Then every float array, then the int table, then the bytes */
+	floatCount = fftSize											/* window */
+				+ fftSize											/* twiddle */
+				+ (size_t) threadCount * 2 * fftSize				/* fftScratch */
+				+ (size_t) skimmer->sampleCapacity * 2				/* samples */
+				+ (size_t) MORSE_SKIMMER_BLOCK_FRAMES * fftSize;	/* levels */
+
+	memorySize = threadCount * sizeof(pthread_t)
+				+ fftSize * sizeof(MorseSkimmerChannel)
+				+ floatCount * sizeof(float)
+				+ fftSize * sizeof(int)
+				+ (size_t) MORSE_SKIMMER_BLOCK_FRAMES * fftSize
+				+ (size_t) fftSize * capacity;
+
+	memorySpace = (char*) allocator->allocate(allocator->userData, memorySize);
+	if (memorySpace == 0) return -1;
+
+	skimmer->workers = (pthread_t*) memorySpace;
+	skimmer->channels = (MorseSkimmerChannel*) (skimmer->workers + threadCount);
+	skimmer->window = (float*) (skimmer->channels + fftSize);
+	skimmer->twiddle = skimmer->window + fftSize;
+	skimmer->fftScratch = skimmer->twiddle + fftSize;
+	skimmer->samples = skimmer->fftScratch + (size_t) threadCount * 2 * fftSize;
+	skimmer->levels = skimmer->samples + (size_t) skimmer->sampleCapacity * 2;
+	skimmer->bitReverse = (int*) (skimmer->levels + (size_t) MORSE_SKIMMER_BLOCK_FRAMES * fftSize);
+	skimmer->marks = (unsigned char*) (skimmer->bitReverse + fftSize);
+	skimmer->ringMemory = (char*) (skimmer->marks + (size_t) MORSE_SKIMMER_BLOCK_FRAMES * fftSize);
+
+
+	/* Hann window, twiddle factors and bit reversed order of the FFT */
+	bits = 0;
+	while ((1 << bits) < fftSize) bits = bits + 1;
+
+	for (index = 0; index < fftSize; index++) {
+
+		skimmer->window[index] = (float) (0.5 - 0.5 * cos(2.0 * MORSE_SKIMMER_PI * index / fftSize));
+
+		reversed = 0;
+		for (value = 0; value < bits; value++) reversed |= ((index >> value) & 1) << (bits - 1 - value);
+		skimmer->bitReverse[index] = reversed;
+	}
+	for (index = 0; index < fftSize / 2; index++) {
+		skimmer->twiddle[2 * index] = (float) cos(2.0 * MORSE_SKIMMER_PI * index / fftSize);
+		skimmer->twiddle[2 * index + 1] = (float) -sin(2.0 * MORSE_SKIMMER_PI * index / fftSize);
+	}
+
+
+	/* Dot length in frames: a dot takes 1.2 / wpm seconds (PARIS) */
+	frameRate = sampleRate / skimmer->hopSize;
+	skimmer->initialDot = (float) (1.2 / MORSE_SKIMMER_WPM * frameRate);
+	skimmer->maxDot = (float) (1.2 / 5 * frameRate);
+
+	memset((void*) skimmer->channels, 0, fftSize * sizeof(MorseSkimmerChannel));
+	for (index = 0; index < fftSize; index++) {
+		skimmer->channels[index].noiseLevel = MORSE_SKIMMER_NO_LEVEL;
+		skimmer->channels[index].dotLength = skimmer->initialDot;
+		morse_resetClassifier(skimmer, skimmer->channels + index);
+	}
+
+
+	/* Extra threads for the whole life of the skimmer, the caller is thread 0 */
+	skimmer->workerCount = 0;
+	skimmer->startedCount = 0;
+	skimmer->phaseNumber = 0;
+	skimmer->busyCount = 0;
+	pthread_mutex_init(&skimmer->phaseLock, 0);
+	pthread_cond_init(&skimmer->phaseStart, 0);
+	pthread_cond_init(&skimmer->phaseDone, 0);
+
+	for (index = 1; index < threadCount; index++) {
+		if (pthread_create(skimmer->workers + skimmer->workerCount, 0, morse_skimmerWorker,
+								(void*) skimmer) != 0) {
+			morse_destroySkimmer(skimmer);
+			return -1;
+		}
+		skimmer->workerCount = skimmer->workerCount + 1;
+	}
+
+	return 0;
+}
+
+
+
+
+void morse_destroySkimmer(MorseSkimmer *skimmer) {
+
+	morse_stopSkimmerWorkers(skimmer);
+	pthread_cond_destroy(&skimmer->phaseDone);
+	pthread_cond_destroy(&skimmer->phaseStart);
+	pthread_mutex_destroy(&skimmer->phaseLock);
+
+	skimmer->allocator->release(skimmer->allocator->userData, (void*) skimmer->workers);
+	memset((void*) skimmer, 0, sizeof(MorseSkimmer));
+}
+
+
+
+
+static void morse_transformFrame(const MorseSkimmer *skimmer, float *frame) {
+
+	register int start, pair;
+	int size, halfSize, twiddleStep, index, partner;
+	float tempReal, tempImag, wReal, wImag, *twiddle;
+
+	for (index = 0; index < skimmer->fftSize; index++) {
+
+		partner = skimmer->bitReverse[index];
+		if (partner <= index) continue;
+
+		tempReal = frame[2 * index];
+		tempImag = frame[2 * index + 1];
+		frame[2 * index] = frame[2 * partner];
+		frame[2 * index + 1] = frame[2 * partner + 1];
+		frame[2 * partner] = tempReal;
+		frame[2 * partner + 1] = tempImag;
+	}
+
+	twiddle = skimmer->twiddle;
+	for (size = 2; size <= skimmer->fftSize; size = size << 1) {
+
+		halfSize = size >> 1;
+		twiddleStep = skimmer->fftSize / size;
+
+		for (start = 0; start < skimmer->fftSize; start += size) {
+			for (pair = 0; pair < halfSize; pair++) {
+
+				wReal = twiddle[2 * pair * twiddleStep];
+				wImag = twiddle[2 * pair * twiddleStep + 1];
+				index = 2 * (start + pair);
+				partner = index + 2 * halfSize;
+
+				tempReal = frame[partner] * wReal - frame[partner + 1] * wImag;
+				tempImag = frame[partner] * wImag + frame[partner + 1] * wReal;
+				frame[partner] = frame[index] - tempReal;
+				frame[partner + 1] = frame[index + 1] - tempImag;
+				frame[index] += tempReal;
+				frame[index + 1] += tempImag;
+			}
+		}
+	}
+}
+
+
+
+
+static void morse_computeSpectra(MorseSkimmer *skimmer, int item, float *scratch) {
+
+	register int frame, bin;
+	int lastFrame, fftSize;
+	const float *samples;
+	float *levels;
+
+	fftSize = skimmer->fftSize;
+	lastFrame = (item + 1) * MORSE_SKIMMER_FRAME_ITEM;
+	if (lastFrame > skimmer->frameCount) lastFrame = skimmer->frameCount;
+
+	for (frame = item * MORSE_SKIMMER_FRAME_ITEM; frame < lastFrame; frame++) {
+
+		samples = skimmer->samples + 2 * frame * skimmer->hopSize;
+		for (bin = 0; bin < fftSize; bin++) {
+			scratch[2 * bin] = samples[2 * bin] * skimmer->window[bin];
+			scratch[2 * bin + 1] = samples[2 * bin + 1] * skimmer->window[bin];
+		}
+
+		morse_transformFrame(skimmer, scratch);
+
+
+		levels = skimmer->levels + (size_t) frame * fftSize;
+		for (bin = 0; bin < fftSize; bin++)
+			levels[bin] = scratch[2 * bin] * scratch[2 * bin] + scratch[2 * bin + 1] * scratch[2 * bin + 1];
+	}
+}
+
+
+
+
+static void morse_computeKeying(MorseSkimmer *skimmer, int item) {
+
+	register int frame, bin;
+	int firstBin, lastBin;
+	float power, level, keyLevel, threshold, carrierLevel, edgeLevel, noiseStep;
+	MorseSkimmerChannel *channel;
+
+	firstBin = item * MORSE_SKIMMER_BIN_ITEM;
+	lastBin = firstBin + MORSE_SKIMMER_BIN_ITEM;
+	if (lastBin > skimmer->fftSize) lastBin = skimmer->fftSize;
+	carrierLevel = (float) (MORSE_SKIMMER_SNR_DB / 10.0 * log(10.0));
+	edgeLevel = (float) log(4.0);
+
+	for (frame = 0; frame < skimmer->frameCount; frame++) {
+		for (bin = firstBin; bin < lastBin; bin++) {
+
+			channel = skimmer->channels + bin;
+			/* For the trackers, power is averaged over 3 frames (2 of them independent) */
+			/* Which halves the spread of the noise. Keying looks at 2 frames only, to */
+			/* Keep the edges sharp. Both are log power, for decibel like tracker steps */
+			power = skimmer->levels[(size_t) frame * skimmer->fftSize + bin];
+			level = (float) log((power + channel->history[0] + channel->history[1]) / 3.0f + 1e-30f);
+			keyLevel = (float) log((power + channel->history[0]) / 2.0f + 1e-30f);
+			channel->history[1] = channel->history[0];
+			channel->history[0] = power;
+
+			if (channel->noiseLevel == MORSE_SKIMMER_NO_LEVEL)
+				channel->noiseLevel = channel->peakLevel = level;
+
+
+			/* Noise floor steps down faster than up, so key down time barely moves it */
+			/* The peak level rises over a few frames, so single noise spikes do not count */
+			/* During warm up it takes 10 times larger steps, to settle from the first level */
+			noiseStep = skimmer->framesSeen + frame < MORSE_SKIMMER_WARMUP ? 10.0f : 1.0f;
+			if (level < channel->noiseLevel)
+				channel->noiseLevel -= MORSE_SKIMMER_NOISE_FALL * noiseStep;
+			else
+				channel->noiseLevel += MORSE_SKIMMER_NOISE_RISE * noiseStep;
+
+			if (level > channel->peakLevel)
+				channel->peakLevel += (level - channel->peakLevel) * MORSE_SKIMMER_PEAK_RISE;
+			else
+				channel->peakLevel -= MORSE_SKIMMER_PEAK_FALL;
+			if (channel->peakLevel < channel->noiseLevel) channel->peakLevel = channel->noiseLevel;
+
+
+			/* Key down above the middle between floor and peak, with some hysteresis */
+			/* Strong signals key down within 6 dB of the peak, so the tails of the */
+			/* Marks (window and averaging) do not eat up the gaps */
+			threshold = (channel->noiseLevel + channel->peakLevel) * 0.5f;
+			threshold += (channel->peakLevel - channel->noiseLevel) * (channel->isMark ? -0.1f : 0.1f);
+			if (threshold < channel->peakLevel - edgeLevel) threshold = channel->peakLevel - edgeLevel;
+			channel->isMark = channel->peakLevel - channel->noiseLevel > carrierLevel
+								&& keyLevel > threshold;
+
+			skimmer->marks[(size_t) bin * MORSE_SKIMMER_BLOCK_FRAMES + frame] =
+											(unsigned char) channel->isMark;
+		}
+	}
+}
+
+
+
+
+static void morse_resetClassifier(MorseSkimmer *skimmer, MorseSkimmerChannel *channel) {
+
+	(void) skimmer;
+	channel->shortMark = 0;
+	channel->longMark = 0;
+	channel->markRun = 0;
+	channel->spaceRun = 0;
+	channel->heldMark = 0;
+	channel->gapRun = 0;
+	channel->letterCode = 1;
+	channel->elementCount = 0;
+}
+
+
+
+
+static void morse_commitMark(MorseSkimmer *skimmer, MorseSkimmerChannel *channel) {
+
+	int isDash;
+	float markLength;
+
+	markLength = (float) channel->heldMark;
+	channel->heldMark = 0;
+
+
+	/* A mark shorter than a third of a dot is a noise spike, the gap simply goes on */
+	if (3.0f * markLength < channel->dotLength) return;
+
+
+	/* Shortest and longest recent marks jump to a new extreme, and drift back slowly */
+	if (channel->shortMark == 0 || markLength < channel->shortMark)
+		channel->shortMark = markLength;
+	else
+		channel->shortMark += (markLength - channel->shortMark) * 0.05f;
+
+	if (markLength > channel->longMark)
+		channel->longMark = markLength;
+	else
+		channel->longMark += (markLength - channel->longMark) * 0.05f;
+
+
+	/* Once both dots and dashes were seen, they are split between the two, */
+	/* Otherwise at 2 units. Either way the dot length follows the mark */
+	if (channel->longMark > 2.0f * channel->shortMark)
+		isDash = markLength * markLength >= channel->shortMark * channel->longMark;
+	else
+		isDash = markLength >= 2.0f * channel->dotLength;
+
+	channel->dotLength += ((isDash ? markLength / 3.0f : markLength) - channel->dotLength) * 0.2f;
+	if (channel->dotLength < 1.0f) channel->dotLength = 1.0f;
+	if (channel->dotLength > skimmer->maxDot) channel->dotLength = skimmer->maxDot;
+
+	if (channel->elementCount <= MORSE_SKIMMER_MAX_ELEMENTS) {
+		channel->letterCode = (channel->letterCode << 1) | (unsigned int) isDash;
+		channel->elementCount = channel->elementCount + 1;
+	}
+	channel->gapRun = channel->spaceRun;
+}
+
+
+
+
+static void morse_closeLetter(MorseSkimmer *skimmer, MorseSkimmerChannel *channel, int bin) {
+
+	char letter[MORSE_SKIMMER_MAX_ELEMENTS + 1];
+	unsigned int code, capacity, tail;
+	int letterLen, elementIndex;
+	register int letterIndex;
+
+	code = channel->letterCode;
+	channel->letterCode = 1;
+	channel->elementCount = 0;
+
+
+	/* Only letters of the symbol table are written, so the stream always converts */
+	if (code <= 1 || code >= 128 || morse_codeToAscii[code] == 0) return;
+
+	letterLen = 0;
+	if (channel->pendingSeparator != 0) letter[letterLen++] = channel->pendingSeparator;
+	for (elementIndex = 0; (code >> (elementIndex + 1)) > 1; elementIndex++);
+	for (; elementIndex >= 0; elementIndex--)
+		letter[letterLen++] = ((code >> elementIndex) & 1) != 0 ? MORSE_DASH : MORSE_DOT;
+
+	capacity = skimmer->ringMask + 1;
+	tail = channel->ringTail;
+	if (capacity - (tail - channel->ringHead) < (unsigned int) letterLen) {
+		channel->status |= MORSE_SKIMMER_OVERFLOW;
+		return;
+	}
+
+	for (letterIndex = 0; letterIndex < letterLen; letterIndex++, tail++)
+		skimmer->ringMemory[(size_t) bin * capacity + (tail & skimmer->ringMask)] = letter[letterIndex];
+	channel->ringTail = tail;
+	channel->pendingSeparator = MORSE_LETTER_SEPARATOR;
+}
+
+
+
+
+static void morse_finishSignal(MorseSkimmer *skimmer, MorseSkimmerChannel *channel, int bin) {
+
+	if (channel->heldMark > 0) morse_commitMark(skimmer, channel);
+	if (channel->elementCount > 0) morse_closeLetter(skimmer, channel, bin);
+	if (channel->pendingSeparator != 0) channel->pendingSeparator = MORSE_WORD_SEPARATOR;
+
+	morse_resetClassifier(skimmer, channel);
+}
+
+
+
+
+static void morse_classifyKeying(MorseSkimmer *skimmer, int item) {
+
+	register int frame, bin;
+	int firstBin, lastBin;
+	const unsigned char *marks;
+	MorseSkimmerChannel *channel;
+
+	firstBin = item * MORSE_SKIMMER_BIN_ITEM;
+	lastBin = firstBin + MORSE_SKIMMER_BIN_ITEM;
+	if (lastBin > skimmer->fftSize) lastBin = skimmer->fftSize;
+
+	for (bin = firstBin; bin < lastBin; bin++) {
+
+		channel = skimmer->channels + bin;
+		if (channel->isActive == 0) continue;
+
+		marks = skimmer->marks + (size_t) bin * MORSE_SKIMMER_BLOCK_FRAMES;
+		for (frame = 0; frame < skimmer->frameCount; frame++) {
+
+			if (marks[frame] != 0) {
+
+				/* Key down: after a gap shorter than a quarter dot, the held mark goes on */
+				if (channel->markRun == 0) {
+					if (channel->heldMark > 0) {
+						channel->markRun = channel->heldMark + channel->spaceRun;
+						channel->heldMark = 0;
+					}
+					channel->spaceRun = 0;
+				}
+				channel->markRun = channel->markRun + 1;
+				continue;
+			}
+
+			if (channel->markRun > 0) {
+				channel->heldMark = channel->markRun;
+				channel->markRun = 0;
+				channel->spaceRun = 0;
+			}
+			channel->spaceRun = channel->spaceRun + 1;
+			channel->gapRun = channel->gapRun + 1;
+
+			if (channel->heldMark > 0 && 4.0f * channel->spaceRun >= channel->dotLength)
+				morse_commitMark(skimmer, channel);
+
+
+			/* Letter gap is split from the element gap at 2 units, word gap at 5 */
+			if (channel->heldMark == 0) {
+				if (channel->elementCount > 0 && channel->gapRun >= 2.0f * channel->dotLength)
+					morse_closeLetter(skimmer, channel, bin);
+				if (channel->pendingSeparator == MORSE_LETTER_SEPARATOR
+						&& channel->gapRun >= 5.0f * channel->dotLength)
+					channel->pendingSeparator = MORSE_WORD_SEPARATOR;
+			}
+		}
+	}
+}
+
+
+
+
+static void *morse_skimmerWorker(void *skimmerArgument) {
+
+	MorseSkimmer *skimmer;
+	unsigned int seenPhase;
+	int threadIndex;
+	float *scratch;
+
+	skimmer = (MorseSkimmer*) skimmerArgument;
+	threadIndex = __atomic_add_fetch(&skimmer->startedCount, 1, __ATOMIC_RELAXED);
+	scratch = skimmer->fftScratch + (size_t) threadIndex * 2 * skimmer->fftSize;
+
+
+	/* Every phase is waited for by phaseNumber, the caller only starts the next */
+	/* One when all workers are done, so none is missed. The lock also publishes */
+	/* The data of the block to the workers and their results back to the caller */
+	pthread_mutex_lock(&skimmer->phaseLock);
+	seenPhase = 0;
+	while (1) {
+
+		while (skimmer->phaseNumber == seenPhase)
+			pthread_cond_wait(&skimmer->phaseStart, &skimmer->phaseLock);
+		seenPhase = skimmer->phaseNumber;
+		if (skimmer->phase == MORSE_SKIMMER_PHASE_EXIT) break;
+
+		pthread_mutex_unlock(&skimmer->phaseLock);
+		morse_runSkimmerItems(skimmer, scratch);
+		pthread_mutex_lock(&skimmer->phaseLock);
+
+		skimmer->busyCount = skimmer->busyCount - 1;
+		if (skimmer->busyCount == 0) pthread_cond_signal(&skimmer->phaseDone);
+	}
+	pthread_mutex_unlock(&skimmer->phaseLock);
+
+	return 0;
+}
+
+
+
+
+static void morse_runSkimmerItems(MorseSkimmer *skimmer, float *scratch) {
+
+	int item;
+
+	while (1) {
+
+		item = __atomic_fetch_add(&skimmer->nextItem, 1, __ATOMIC_RELAXED);
+		if (item >= skimmer->itemCount) break;
+
+		switch (skimmer->phase) {
+			case MORSE_SKIMMER_PHASE_SPECTRA:
+				morse_computeSpectra(skimmer, item, scratch);
+				break;
+			case MORSE_SKIMMER_PHASE_KEYING:
+				morse_computeKeying(skimmer, item);
+				break;
+			default:
+				morse_classifyKeying(skimmer, item);
+				break;
+		}
+	}
+}
+
+
+
+
+static void morse_runSkimmerPhase(MorseSkimmer *skimmer, int phase, int itemCount) {
+
+	if (skimmer->workerCount == 0) {
+		skimmer->phase = phase;
+		skimmer->itemCount = itemCount;
+		skimmer->nextItem = 0;
+		morse_runSkimmerItems(skimmer, skimmer->fftScratch);
+		return;
+	}
+
+
+	/* Wake the workers, work along with them, then wait for the last one */
+	pthread_mutex_lock(&skimmer->phaseLock);
+	skimmer->phase = phase;
+	skimmer->itemCount = itemCount;
+	skimmer->nextItem = 0;
+	skimmer->busyCount = skimmer->workerCount;
+	skimmer->phaseNumber = skimmer->phaseNumber + 1;
+	pthread_cond_broadcast(&skimmer->phaseStart);
+	pthread_mutex_unlock(&skimmer->phaseLock);
+
+	morse_runSkimmerItems(skimmer, skimmer->fftScratch);
+
+	pthread_mutex_lock(&skimmer->phaseLock);
+	while (skimmer->busyCount > 0)
+		pthread_cond_wait(&skimmer->phaseDone, &skimmer->phaseLock);
+	pthread_mutex_unlock(&skimmer->phaseLock);
+}
+
+
+
+
+static void morse_stopSkimmerWorkers(MorseSkimmer *skimmer) {
+
+	register int threadIndex;
+
+	pthread_mutex_lock(&skimmer->phaseLock);
+	skimmer->phase = MORSE_SKIMMER_PHASE_EXIT;
+	skimmer->phaseNumber = skimmer->phaseNumber + 1;
+	pthread_cond_broadcast(&skimmer->phaseStart);
+	pthread_mutex_unlock(&skimmer->phaseLock);
+
+	for (threadIndex = 0; threadIndex < skimmer->workerCount; threadIndex++)
+		pthread_join(skimmer->workers[threadIndex], 0);
+	skimmer->workerCount = 0;
+}
+
+
+
+
+static void morse_processSkimmerBlock(MorseSkimmer *skimmer, int frameCount) {
+
+	register int bin;
+	int fftSize, binItems, isCarrier, usedCount;
+	float carrierLevel, releaseLevel, peak;
+	MorseSkimmerChannel *channel;
+
+	fftSize = skimmer->fftSize;
+	skimmer->frameCount = frameCount;
+	binItems = (fftSize + MORSE_SKIMMER_BIN_ITEM - 1) / MORSE_SKIMMER_BIN_ITEM;
+
+	morse_runSkimmerPhase(skimmer, MORSE_SKIMMER_PHASE_SPECTRA,
+					(frameCount + MORSE_SKIMMER_FRAME_ITEM - 1) / MORSE_SKIMMER_FRAME_ITEM);
+	morse_runSkimmerPhase(skimmer, MORSE_SKIMMER_PHASE_KEYING, binItems);
+
+
+	/* A carrier leaks into the bins next to it, only the strongest bin of the */
+	/* Group is a signal. Ties go to the lower bin. A signal is kept until it */
+	/* Falls 3 dB below the level which started it */
+	carrierLevel = (float) (MORSE_SKIMMER_SNR_DB / 10.0 * log(10.0));
+	releaseLevel = (float) ((MORSE_SKIMMER_SNR_DB - 3.0) / 10.0 * log(10.0));
+	for (bin = 0; bin < fftSize; bin++) {
+
+		channel = skimmer->channels + bin;
+		peak = channel->peakLevel;
+		isCarrier = skimmer->framesSeen + frameCount >= MORSE_SKIMMER_WARMUP
+					&& peak - channel->noiseLevel > (channel->isActive ? releaseLevel : carrierLevel)
+					&& peak >= skimmer->channels[(bin + fftSize - 1) % fftSize].peakLevel
+					&& peak > skimmer->channels[(bin + 1) % fftSize].peakLevel;
+
+		if (isCarrier != 0 && channel->isActive == 0) {
+			morse_resetClassifier(skimmer, channel);
+			channel->dotLength = skimmer->initialDot;
+		}
+		else if (isCarrier == 0 && channel->isActive != 0) {
+			morse_finishSignal(skimmer, channel, bin);
+		}
+		channel->isActive = isCarrier;
+	}
+
+	morse_runSkimmerPhase(skimmer, MORSE_SKIMMER_PHASE_LETTERS, binItems);
+	skimmer->framesSeen += frameCount;
+
+
+	/* Keep the samples which belong to frames of the next block */
+	usedCount = frameCount * skimmer->hopSize;
+	memmove((void*) skimmer->samples, (const void*) (skimmer->samples + 2 * usedCount),
+				2 * (skimmer->sampleCount - usedCount) * sizeof(float));
+	skimmer->sampleCount -= usedCount;
+}
+
+
+
+
+int morse_processSkimmer(MorseSkimmer *skimmer, const float *iqSamples, int sampleCount) {
+
+	register int bin;
+	int takeCount;
+
+	while (sampleCount > 0) {
+
+		takeCount = skimmer->sampleCapacity - skimmer->sampleCount;
+		if (takeCount > sampleCount) takeCount = sampleCount;
+
+		memcpy((void*) (skimmer->samples + 2 * skimmer->sampleCount), (const void*) iqSamples,
+					2 * takeCount * sizeof(float));
+		skimmer->sampleCount += takeCount;
+		iqSamples = iqSamples + 2 * takeCount;
+		sampleCount = sampleCount - takeCount;
+
+
+		/* Only a full buffer (one whole block) is processed, so small input chunks */
+		/* Do not wake the threads for a few frames each */
+		if (skimmer->sampleCount < skimmer->sampleCapacity) break;
+		morse_processSkimmerBlock(skimmer, MORSE_SKIMMER_BLOCK_FRAMES);
+	}
+
+	for (bin = 0; bin < skimmer->fftSize; bin++) {
+		if (skimmer->channels[bin].status != MORSE_SKIMMER_OK) return -1;
+	}
+
+	return 0;
+}
+
+
+
+
+void morse_flushSkimmer(MorseSkimmer *skimmer) {
+
+	register int bin;
+
+	if (skimmer->sampleCount >= skimmer->fftSize)
+		morse_processSkimmerBlock(skimmer,
+						(skimmer->sampleCount - skimmer->fftSize) / skimmer->hopSize + 1);
+
+	for (bin = 0; bin < skimmer->fftSize; bin++) {
+		if (skimmer->channels[bin].isActive != 0)
+			morse_finishSignal(skimmer, skimmer->channels + bin, bin);
+	}
+}
+
+
+
+
+int morse_getSkimmerSignals(MorseSkimmer *skimmer, MorseSkimmerSignal *signals, int maxSignals,
+								int *signalCount)
+{
+
+	register int bin;
+	int count, pending;
+	MorseSkimmerChannel *channel;
+	MorseSkimmerSignal *signal;
+
+	count = 0;
+	for (bin = 0; bin < skimmer->fftSize; bin++) {
+
+		channel = skimmer->channels + bin;
+		pending = (int) (channel->ringTail - channel->ringHead);
+		if (channel->isActive == 0 && pending == 0) continue;
+
+		if (count == maxSignals) {
+			*signalCount = count;
+			return -1;
+		}
+
+		signal = signals + count;
+		signal->bin = bin;
+		signal->frequency = (bin < skimmer->fftSize / 2 ? bin : bin - skimmer->fftSize)
+								* skimmer->sampleRate / skimmer->fftSize;
+		signal->snr = (channel->peakLevel - channel->noiseLevel) * 10.0 / log(10.0);
+		signal->wpm = 1.2 * skimmer->sampleRate / (skimmer->hopSize * channel->dotLength);
+		signal->isActive = channel->isActive;
+		signal->pending = pending;
+		count = count + 1;
+	}
+
+	*signalCount = count;
+	return 0;
+}
+
+
+
+
+int morse_readSkimmerChannel(MorseSkimmer *skimmer, int bin,
+								char *morseOutputString, int maxLen, int *morseStringLen)
+{
+
+	unsigned int head, available, firstPart, offset;
+	MorseSkimmerChannel *channel;
+	char *ring;
+
+	if (bin < 0 || bin >= skimmer->fftSize) return -1;
+
+	channel = skimmer->channels + bin;
+	head = channel->ringHead;
+	available = channel->ringTail - head;
+	if (maxLen >= 0 && available > (unsigned int) maxLen) available = (unsigned int) maxLen;
+
+
+	/* The readable region may wrap around the end of the ring, copy in two parts */
+	ring = skimmer->ringMemory + (size_t) bin * (skimmer->ringMask + 1);
+	offset = head & skimmer->ringMask;
+	firstPart = skimmer->ringMask + 1 - offset;
+	if (firstPart > available) firstPart = available;
+
+	memcpy((void*) morseOutputString, (const void*) (ring + offset), firstPart);
+	memcpy((void*) (morseOutputString + firstPart), (const void*) ring, available - firstPart);
+
+	channel->ringHead = head + available;
+	channel->status = MORSE_SKIMMER_OK;
+	*morseStringLen = (int) available;
+
+	return 0;
+}
+
+
+
+
+int morse_getSkimmerChannelStatus(MorseSkimmer *skimmer, int bin) {
+
+	if (bin < 0 || bin >= skimmer->fftSize) return -1;
+	return skimmer->channels[bin].status;
+}
@@ -0,0 +1,221 @@
+
+
+/************************************************************************************
+	Program Interface of Morse Library Wideband CW Skimmer
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef MORSELIB_SKIMMER_H
+#define MORSELIB_SKIMMER_H
+
+
+
+
+
+
+
+#include <pthread.h>
+#include "MorseLib.h"
+
+
+
+/*
+ * Decoding of many CW signals at once from a wideband IQ sample stream (SDR)
+ *
+ * The stream is channelized by a Hann windowed radix-2 FFT with half overlap
+ * Every FFT bin is one channel, with its own noise floor and peak level trackers
+ * A bin holds a carrier when its peak stands high enough over its noise floor and
+ * Over both neighbour bins. Such a bin is keyed frame by frame (mark / space)
+ * And a classifier with an adaptive dot length turns its runs into native morse
+ * Code (".-/-...|-.-."), collected in a ring buffer per bin, ready for
+ * morse_convMorseToAscii()
+ *
+ * Samples are processed in full blocks of frames, each block in three phases which
+ * Are spread over a pool of threads: spectra by frame, then levels and keying by
+ * Bin, then classification by bin. The threads are started once, by
+ * morse_createSkimmer(), and wait on a condition variable between phases
+ * The last partial block is processed by morse_flushSkimmer()
+ *
+ * The noise floors settle during the first 200 frames (about 1 second at 48 kHz
+ * With 512 bins), no signal is reported before that
+ *
+ * Needs POSIX threads and the math library, link with -lpthread -lm
+*/
+
+#define MORSE_SKIMMER_BLOCK_FRAMES 256			/* FFT frames per processed block */
+#define MORSE_SKIMMER_SNR_DB 15.0				/* Carrier peak over noise floor */
+#define MORSE_SKIMMER_WPM 20					/* Initial speed of a new signal */
+#define MORSE_SKIMMER_MAX_ELEMENTS 7			/* Longest letter, longer ones are dropped */
+
+#define MORSE_SKIMMER_OK 0
+#define MORSE_SKIMMER_OVERFLOW 1				/* Ring buffer was full, letters were lost */
+
+
+
+/* Tracker and classifier state of one FFT bin */
+typedef struct MorseSkimmerChannel_ {
+
+	float history[2];						/* Power of the two frames before */
+	float noiseLevel;						/* Natural log of power */
+	float peakLevel;
+	int isMark;								/* Keying of the last frame, for hysteresis */
+	int isActive;
+
+	float dotLength;						/* In frames */
+	float shortMark;						/* Recent dot and dash lengths, 0 if none yet */
+	float longMark;
+	int markRun;
+	int spaceRun;
+	int heldMark;							/* Finished mark, waiting for its gap to be confirmed */
+	int gapRun;								/* Space frames since the last element */
+	unsigned int letterCode;				/* Packed letter being collected, 1 if none */
+	int elementCount;
+	char pendingSeparator;					/* Written before the next letter, 0 if none */
+
+	int status;
+	unsigned int ringHead;
+	unsigned int ringTail;
+
+} MorseSkimmerChannel;
+
+
+
+typedef struct MorseSkimmer_ {
+
+	double sampleRate;
+	int fftSize;
+	int hopSize;
+	int threadCount;
+	float initialDot;
+	float maxDot;
+
+	float *window;
+	float *twiddle;							/* cos, sin pairs of the first half circle */
+	int *bitReverse;
+	float *fftScratch;						/* One complex frame per thread */
+
+	float *samples;							/* Interleaved I, Q waiting for the next block */
+	int sampleCount;
+	int sampleCapacity;
+
+	float *levels;							/* Power, [frame][bin] */
+	unsigned char *marks;					/* Keying, [bin][frame] */
+	int frameCount;
+	unsigned long framesSeen;				/* Frames of all earlier blocks */
+
+	MorseSkimmerChannel *channels;
+	char *ringMemory;
+	unsigned int ringMask;
+
+	pthread_t *workers;						/* Extra threads, the caller is thread 0 */
+	int workerCount;
+	int startedCount;						/* Hands out scratch frames to the workers */
+	pthread_mutex_t phaseLock;
+	pthread_cond_t phaseStart;				/* Workers wait here for the next phase */
+	pthread_cond_t phaseDone;				/* The caller waits here for the workers */
+	unsigned int phaseNumber;				/* Counts started phases */
+	int busyCount;							/* Workers not done with the current phase */
+	int phase;
+	int nextItem;
+	int itemCount;
+
+	const MorseAllocator *allocator;
+
+} MorseSkimmer;
+
+
+
+typedef struct MorseSkimmerSignal_ {
+
+	int bin;
+	double frequency;						/* Offset from the centre frequency in Hz */
+	double snr;								/* Peak over noise floor in dB */
+	double wpm;								/* From the last measured dot length */
+	int isActive;							/* 0 if gone, but output is still unread */
+	int pending;							/* Unread morse characters */
+
+} MorseSkimmerSignal;
+
+
+
+/*
+	Create a skimmer for IQ samples at sampleRate, with fftSize bins (a power
+	of 2, eg. 512 at 48 kHz gives 94 Hz bins and 5.3 ms frames), threadCount
+	Threads and a morse ring of ringCapacity characters per bin
+	The threadCount - 1 extra threads are started here and run until
+	morse_destroySkimmer()
+
+	Returns 0 for success, -1 for bad arguments, memory allocation or thread failure
+	One must call morse_destroySkimmer() after being done with the skimmer
+*/
+
+int morse_createSkimmer(MorseSkimmer *skimmer, double sampleRate, int fftSize,
+								int threadCount, int ringCapacity);
+
+int morse_createSkimmerWith(MorseSkimmer *skimmer, double sampleRate, int fftSize,
+								int threadCount, int ringCapacity, const MorseAllocator *allocator);
+
+void morse_destroySkimmer(MorseSkimmer *skimmer);
+
+
+
+/*
+	Feed sampleCount IQ samples (2 floats each, I then Q)
+	Input may be split anywhere, samples of an unfinished block are kept
+	Until the block is full or morse_flushSkimmer() is called
+
+	Returns 0 for success, -1 if a ring buffer overflowed (see morse_getSkimmerSignals())
+*/
+
+int morse_processSkimmer(MorseSkimmer *skimmer, const float *iqSamples, int sampleCount);
+
+
+
+/*
+	End of input: process the frames of the unfinished block, then close the
+	Letter in progress on every bin
+*/
+
+void morse_flushSkimmer(MorseSkimmer *skimmer);
+
+
+
+/*
+	List the bins which hold a carrier or unread morse code
+
+	out:
+		MorseSkimmerSignal *signals	- Up to maxSignals signals, by bin
+		int *signalCount			- Number of signals listed
+
+	Returns 0 for success, -1 if there were more than maxSignals signals
+*/
+
+int morse_getSkimmerSignals(MorseSkimmer *skimmer, MorseSkimmerSignal *signals, int maxSignals,
+								int *signalCount);
+
+
+
+/*
+	Read up to maxLen morse characters of a bin, a negative maxLen reads all
+	Returns 0 for success, -1 for an invalid bin
+*/
+
+int morse_readSkimmerChannel(MorseSkimmer *skimmer, int bin,
+								char *morseOutputString, int maxLen, int *morseStringLen);
+
+int morse_getSkimmerChannelStatus(MorseSkimmer *skimmer, int bin);
+
+
+
+
+
+
+
+#endif
@@ -0,0 +1,284 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Dictionary-Free Conversions
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "MorseLib.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+/*
+ *
+ * Packed morse letter of each ASCII character and the reverse table,
+ * See MorseLib_Symbol_Table.c
+ *
+*/
+extern const unsigned char morse_asciiToCode[128];
+
+extern const char morse_codeToAscii[128];
+
+
+
+/* Binary segment of each native morse character, arrays keep them in flash */
+static const char binarySegments[4][5] = {
+	BINARY_DOT, BINARY_DASH, BINARY_LETTER_SEPARATOR, BINARY_WORD_SEPARATOR
+};
+
+static const char segmentToMorse[4] = {
+	MORSE_DOT, MORSE_DASH, MORSE_LETTER_SEPARATOR, MORSE_WORD_SEPARATOR
+};
+
+
+
+/*
+ *
+ * Internal (Static) function to close a letter, the node of the dichotomic tree
+ * Writes its ASCII character, if the node is not empty
+ * Returns 0 for success, -1 if the node has no letter
+ *
+*/
+static int morse_closeStaticLetter(unsigned int node, char *AsciiOutputString, int *outputCounter);
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+static int morse_closeStaticLetter(unsigned int node, char *AsciiOutputString, int *outputCounter) {
+
+	if (node == 1) return 0;
+	if (node >= 128 || morse_codeToAscii[node] == 0) return -1;
+
+	AsciiOutputString[(*outputCounter)++] = morse_codeToAscii[node];
+
+	return 0;
+}
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL STATIC FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_convAsciiToMorseStatic(char *AsciiInputString, int AsciiStringLen,
+								char *morseOutputString, int *morseStringLen)
+{
+
+	register int globalInputIndex;
+	int globalOutputCounter;
+	unsigned int code, elementMask;
+	unsigned char asciiIndex;
+
+	globalOutputCounter = 0;
+
+	for (globalInputIndex = 0; globalInputIndex < AsciiStringLen; globalInputIndex++) {
+
+		asciiIndex = (unsigned char) AsciiInputString[globalInputIndex];
+		code = asciiIndex < 128 ? morse_asciiToCode[asciiIndex] : 0;
+
+		if (code == 0) return -1;
+
+		if (code == 1) {
+			morseOutputString[globalOutputCounter++] = MORSE_WORD_SEPARATOR;
+			continue;
+		}
+
+
+		/* Elements below the sentinel bit, most significant first */
+		elementMask = 1;
+		while ((elementMask << 1) <= code) elementMask = elementMask << 1;
+
+		for (elementMask = elementMask >> 1; elementMask != 0; elementMask = elementMask >> 1)
+			morseOutputString[globalOutputCounter++] = (code & elementMask) != 0 ? MORSE_DASH : MORSE_DOT;
+
+
+		/* Letter separator between two letters, never next to a SPACE */
+		if (globalInputIndex < AsciiStringLen - 1 && AsciiInputString[globalInputIndex + 1] != ' ')
+			morseOutputString[globalOutputCounter++] = MORSE_LETTER_SEPARATOR;
+	}
+
+	*morseStringLen = globalOutputCounter;
+
+	return 0;
+}
+
+
+
+
+int morse_convMorseToAsciiStatic(char *morseInputString, int morseStringLen,
+								char *AsciiOutputString, int *AsciiStringLen)
+{
+
+	register int globalInputIndex;
+	int globalOutputCounter, element;
+	unsigned int node;
+	const unsigned char *input;
+
+	input = (const unsigned char*) morseInputString;
+	globalInputIndex = 0;
+	globalOutputCounter = 0;
+	node = 1;
+
+	while (globalInputIndex < morseStringLen) {
+
+
+		/* Plain '.' and '-', or the middle dot (U+00B7) and minus sign (U+2212) */
+		element = -1;
+		if (input[globalInputIndex] == MORSE_DOT) {
+			element = 0;
+			globalInputIndex += 1;
+		}
+		else if (input[globalInputIndex] == MORSE_DASH) {
+			element = 1;
+			globalInputIndex += 1;
+		}
+		else if (input[globalInputIndex] == 0xC2 && globalInputIndex + 1 < morseStringLen
+				 && input[globalInputIndex + 1] == 0xB7) {
+			element = 0;
+			globalInputIndex += 2;
+		}
+		else if (input[globalInputIndex] == 0xE2 && globalInputIndex + 2 < morseStringLen
+				 && input[globalInputIndex + 1] == 0x88 && input[globalInputIndex + 2] == 0x92) {
+			element = 1;
+			globalInputIndex += 3;
+		}
+
+		if (element != -1) {
+
+
+			/* Walk down the tree, a node past the last level can never be a letter */
+			if (node < 128) node = (node << 1) | (unsigned int) element;
+			continue;
+		}
+
+		if (input[globalInputIndex] != MORSE_LETTER_SEPARATOR
+			&& input[globalInputIndex] != MORSE_WORD_SEPARATOR) return -1;
+
+		if (morse_closeStaticLetter(node, AsciiOutputString, &globalOutputCounter) == -1) return -1;
+		node = 1;
+
+		if (input[globalInputIndex] == MORSE_WORD_SEPARATOR)
+			AsciiOutputString[globalOutputCounter++] = ' ';
+
+		globalInputIndex = globalInputIndex + 1;
+	}
+
+	if (morse_closeStaticLetter(node, AsciiOutputString, &globalOutputCounter) == -1) return -1;
+
+	*AsciiStringLen = globalOutputCounter;
+
+	return 0;
+}
+
+
+
+
+int morse_convMorseToBinaryStatic(char *morseInputSequence, int morseSequenceLen,
+								char *binaryOutputSequence, int *binarySequenceLen)
+{
+
+	register int globalInputIndex;
+	int globalOutputCounter, segmentIndex;
+	const char *segment;
+
+	globalOutputCounter = 0;
+
+	for (globalInputIndex = 0; globalInputIndex < morseSequenceLen; globalInputIndex++) {
+
+		switch (morseInputSequence[globalInputIndex]) {
+			case MORSE_DOT:					segmentIndex = 0; break;
+			case MORSE_DASH:				segmentIndex = 1; break;
+			case MORSE_LETTER_SEPARATOR:	segmentIndex = 2; break;
+			case MORSE_WORD_SEPARATOR:		segmentIndex = 3; break;
+			default:						return -1;
+		}
+
+		for (segment = binarySegments[segmentIndex]; *segment != '\0'; segment++)
+			binaryOutputSequence[globalOutputCounter++] = *segment;
+	}
+
+	*binarySequenceLen = globalOutputCounter;
+
+	return 0;
+}
+
+
+
+
+int morse_convBinaryToMorseStatic(char *binaryInputString, int binarySequenceLen,
+								char *morseOutputString, int *morseSequenceLen)
+{
+
+	register int globalInputIndex;
+	int globalOutputCounter, onesCount;
+
+	globalOutputCounter = 0;
+	onesCount = 0;
+
+	for (globalInputIndex = 0; globalInputIndex < binarySequenceLen; globalInputIndex++) {
+
+
+		/* A segment is up to three '1' closed by a '0' */
+		if (binaryInputString[globalInputIndex] == '1') {
+			if (++onesCount > 3) return -1;
+			continue;
+		}
+		if (binaryInputString[globalInputIndex] != '0') return -1;
+
+		morseOutputString[globalOutputCounter++] = segmentToMorse[onesCount];
+		onesCount = 0;
+	}
+
+
+	/* An unfinished segment at the end is an error, as in the dictionary version */
+	if (onesCount > 0) return -1;
+
+	*morseSequenceLen = globalOutputCounter;
+
+	return 0;
+}
@@ -0,0 +1,328 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Compact Symbol Arrays
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <string.h>
+#include "MorseLib.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+/*
+ *
+ * Packed morse letter of each ASCII character and the reverse table,
+ * See MorseLib_Symbol_Table.c. A symbol uses the very same packing
+ *
+*/
+extern const unsigned char morse_asciiToCode[128];
+
+extern const char morse_codeToAscii[128];
+
+
+
+/*
+ * Elements of the text formats, in both directions: DOT, DASH, letter separator
+ * And word separator, written as native morse characters or as binary segments
+*/
+#define MORSE_ELEMENT_DOT 0
+#define MORSE_ELEMENT_DASH 1
+#define MORSE_ELEMENT_LETTER_GAP 2
+#define MORSE_ELEMENT_WORD_GAP 3
+
+static const char morseElements[4][5] = { ".", "-", "/", "|" };
+static const char binaryElements[4][5] = { BINARY_DOT, BINARY_DASH,
+										   BINARY_LETTER_SEPARATOR, BINARY_WORD_SEPARATOR };
+
+
+
+/*
+ *
+ * Internal (Static) function to feed one element into the open symbol
+ * A DOT or DASH extends the open letter, a gap closes it, a word gap also
+ * Appends MORSE_SYMBOL_WORD_GAP
+ *
+ * Returns 0 for success, -1 for a letter longer than MORSE_SYMBOL_MAX_ELEMENTS
+ *
+*/
+static int morse_feedSymbolElement(unsigned int *openSymbol, int element,
+								unsigned short *symbols, int *symbolCount);
+
+
+
+/*
+ *
+ * Internal (Static) function to write symbols as text, every element is
+ * Written with the given string. Letters are separated by a letter separator,
+ * Except next to a word gap, just like morse_convAsciiToMorse() does
+ *
+ * Returns 0 for success, -1 for an invalid symbol
+ *
+*/
+static int morse_renderSymbols(unsigned short *symbols, int symbolCount, const char elements[][5],
+								char *textOutput, int *textLen);
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+static int morse_feedSymbolElement(unsigned int *openSymbol, int element,
+								unsigned short *symbols, int *symbolCount)
+{
+
+	if (element == MORSE_ELEMENT_DOT || element == MORSE_ELEMENT_DASH) {
+
+		if (*openSymbol >= (1U << MORSE_SYMBOL_MAX_ELEMENTS)) return -1;
+		*openSymbol = (*openSymbol << 1) | (unsigned int) element;
+		return 0;
+	}
+
+	if (*openSymbol > 1) {
+		symbols[(*symbolCount)++] = (unsigned short) *openSymbol;
+		*openSymbol = 1;
+	}
+
+	if (element == MORSE_ELEMENT_WORD_GAP) symbols[(*symbolCount)++] = MORSE_SYMBOL_WORD_GAP;
+
+	return 0;
+}
+
+
+
+
+static int morse_renderSymbols(unsigned short *symbols, int symbolCount, const char elements[][5],
+								char *textOutput, int *textLen)
+{
+
+	register int symbolIndex;
+	int outputCounter, elementLen[4];
+	unsigned int symbol, elementMask, element;
+
+	for (element = 0; element < 4; element++) elementLen[element] = strlen(elements[element]);
+
+	outputCounter = 0;
+
+	for (symbolIndex = 0; symbolIndex < symbolCount; symbolIndex++) {
+
+		symbol = symbols[symbolIndex];
+
+		if (symbol == MORSE_SYMBOL_INVALID) return -1;
+
+		if (symbol == MORSE_SYMBOL_WORD_GAP) {
+			element = MORSE_ELEMENT_WORD_GAP;
+			memcpy((void*) (textOutput + outputCounter), (const void*) elements[element],
+														elementLen[element]);
+			outputCounter += elementLen[element];
+			continue;
+		}
+
+
+		/* Elements of the letter, most significant bit below the sentinel first */
+		elementMask = 1;
+		while ((elementMask << 1) <= symbol) elementMask = elementMask << 1;
+
+		for (elementMask = elementMask >> 1; elementMask != 0; elementMask = elementMask >> 1) {
+			element = (symbol & elementMask) != 0 ? MORSE_ELEMENT_DASH : MORSE_ELEMENT_DOT;
+			memcpy((void*) (textOutput + outputCounter), (const void*) elements[element],
+														elementLen[element]);
+			outputCounter += elementLen[element];
+		}
+
+		if (symbolIndex + 1 < symbolCount && symbols[symbolIndex + 1] != MORSE_SYMBOL_WORD_GAP) {
+			element = MORSE_ELEMENT_LETTER_GAP;
+			memcpy((void*) (textOutput + outputCounter), (const void*) elements[element],
+														elementLen[element]);
+			outputCounter += elementLen[element];
+		}
+	}
+
+	*textLen = outputCounter;
+
+	return 0;
+}
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL SYMBOL FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+int morse_convAsciiToSymbols(char *AsciiInputString, int AsciiStringLen,
+								unsigned short *symbolOutput, int *symbolCount)
+{
+
+	register int globalInputIndex;
+	unsigned char asciiIndex;
+
+	for (globalInputIndex = 0; globalInputIndex < AsciiStringLen; globalInputIndex++) {
+
+		asciiIndex = (unsigned char) AsciiInputString[globalInputIndex];
+		if (asciiIndex >= 128 || morse_asciiToCode[asciiIndex] == 0) return -1;
+
+		symbolOutput[globalInputIndex] = morse_asciiToCode[asciiIndex];
+	}
+
+	*symbolCount = AsciiStringLen;
+
+	return 0;
+}
+
+
+
+
+int morse_convSymbolsToAscii(unsigned short *symbolInput, int symbolCount,
+								char *AsciiOutputString, int *AsciiStringLen)
+{
+
+	register int symbolIndex;
+	unsigned int symbol;
+
+	for (symbolIndex = 0; symbolIndex < symbolCount; symbolIndex++) {
+
+		symbol = symbolInput[symbolIndex];
+		if (symbol >= 128 || morse_codeToAscii[symbol] == 0) return -1;
+
+		AsciiOutputString[symbolIndex] = morse_codeToAscii[symbol];
+	}
+
+	*AsciiStringLen = symbolCount;
+
+	return 0;
+}
+
+
+
+
+int morse_convMorseToSymbols(char *morseInputString, int morseStringLen,
+								unsigned short *symbolOutput, int *symbolCount)
+{
+
+	register int globalInputIndex;
+	int symbolCounter, element;
+	unsigned int openSymbol;
+
+	symbolCounter = 0;
+	openSymbol = 1;
+
+	for (globalInputIndex = 0; globalInputIndex < morseStringLen; globalInputIndex++) {
+
+		switch (morseInputString[globalInputIndex]) {
+			case MORSE_DOT:					element = MORSE_ELEMENT_DOT; break;
+			case MORSE_DASH:				element = MORSE_ELEMENT_DASH; break;
+			case MORSE_LETTER_SEPARATOR:	element = MORSE_ELEMENT_LETTER_GAP; break;
+			case MORSE_WORD_SEPARATOR:		element = MORSE_ELEMENT_WORD_GAP; break;
+			default:						return -1;
+		}
+
+		if (morse_feedSymbolElement(&openSymbol, element, symbolOutput, &symbolCounter) == -1)
+			return -1;
+	}
+
+	morse_feedSymbolElement(&openSymbol, MORSE_ELEMENT_LETTER_GAP, symbolOutput, &symbolCounter);
+	*symbolCount = symbolCounter;
+
+	return 0;
+}
+
+
+
+
+int morse_convSymbolsToMorse(unsigned short *symbolInput, int symbolCount,
+								char *morseOutputString, int *morseStringLen)
+{
+	return morse_renderSymbols(symbolInput, symbolCount, morseElements,
+								morseOutputString, morseStringLen);
+}
+
+
+
+
+int morse_convBinaryToSymbols(char *binaryInputString, int binarySequenceLen,
+								unsigned short *symbolOutput, int *symbolCount)
+{
+
+	register int globalInputIndex;
+	int symbolCounter, onesCount;
+	unsigned int openSymbol;
+
+	symbolCounter = 0;
+	onesCount = 0;
+	openSymbol = 1;
+
+	for (globalInputIndex = 0; globalInputIndex < binarySequenceLen; globalInputIndex++) {
+
+
+		/* A segment is up to three '1' closed by a '0', its element is the count of '1' */
+		if (binaryInputString[globalInputIndex] == '1') {
+			if (++onesCount > MORSE_ELEMENT_WORD_GAP) return -1;
+			continue;
+		}
+		if (binaryInputString[globalInputIndex] != '0') return -1;
+
+		if (morse_feedSymbolElement(&openSymbol, onesCount, symbolOutput, &symbolCounter) == -1)
+			return -1;
+		onesCount = 0;
+	}
+
+	if (onesCount > 0) return -1;
+
+	morse_feedSymbolElement(&openSymbol, MORSE_ELEMENT_LETTER_GAP, symbolOutput, &symbolCounter);
+	*symbolCount = symbolCounter;
+
+	return 0;
+}
+
+
+
+
+int morse_convSymbolsToBinary(unsigned short *symbolInput, int symbolCount,
+								char *binaryOutputString, int *binaryStringLen)
+{
+	return morse_renderSymbols(symbolInput, symbolCount, binaryElements,
+								binaryOutputString, binaryStringLen);
+}
@@ -0,0 +1,83 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Static Symbol Tables
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+/*
+ * Constant lookup tables built from the very same symbol set which
+ * morse_buildMorseAsciiObjectList() loads into the BisTree dictionaries
+ *
+ * A morse letter is packed into one byte: (1 << length) | dashBits
+ * The dash bits are read most significant first, a DOT is 0 and a DASH is 1
+ * So ".-" (A) is 0x05 = 1|0|1, and "-..." (B) is 0x18 = 1|1000
+ * The leading 1 is a sentinel which marks the length, code 0x01 (empty letter)
+ * Stands for the word separator (SPACE), code 0x00 means "no such letter"
+ *
+ * The packed value is also the index of the letter in the dichotomic morse tree
+ * Stored in heap order: children of node n are 2n (DOT) and 2n + 1 (DASH)
+ *
+ * Both tables are const, so they can stay in ROM / flash on small targets
+*/
+
+
+
+
+/* Indexed by ASCII value (0 - 127), gives the packed morse letter */
+const unsigned char morse_asciiToCode[128] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x4D, 0x52, 0x00, 0x00, 0x00, 0x00, 0x5E,
+	0x36, 0x6D, 0x35, 0x2A, 0x73, 0x61, 0x55, 0x32,
+	0x2F, 0x27, 0x23, 0x21, 0x20, 0x30, 0x38, 0x3C,
+	0x3E, 0x3F, 0x00, 0x78, 0x00, 0x31, 0x00, 0x4C,
+	0x00, 0x05, 0x18, 0x1A, 0x0C, 0x02, 0x12, 0x0E,
+	0x10, 0x04, 0x17, 0x0D, 0x14, 0x07, 0x06, 0x0F,
+	0x16, 0x1D, 0x0A, 0x08, 0x03, 0x09, 0x11, 0x0B,
+	0x19, 0x1B, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+
+
+/* Indexed by packed morse letter (0 - 127), gives the ASCII character */
+const char morse_codeToAscii[128] = {
+	0x00, 0x20, 0x45, 0x54, 0x49, 0x41, 0x4E, 0x4D,
+	0x53, 0x55, 0x52, 0x57, 0x44, 0x4B, 0x47, 0x4F,
+	0x48, 0x56, 0x46, 0x00, 0x4C, 0x00, 0x50, 0x4A,
+	0x42, 0x58, 0x43, 0x59, 0x5A, 0x51, 0x00, 0x00,
+	0x34, 0x33, 0x00, 0x32, 0x00, 0x00, 0x00, 0x31,
+	0x00, 0x00, 0x2B, 0x00, 0x00, 0x00, 0x00, 0x30,
+	0x35, 0x3D, 0x2F, 0x00, 0x00, 0x2A, 0x28, 0x00,
+	0x36, 0x00, 0x00, 0x00, 0x37, 0x00, 0x38, 0x39,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x3F, 0x21, 0x00, 0x00,
+	0x00, 0x00, 0x22, 0x00, 0x00, 0x2E, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0x00,
+	0x00, 0x2D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00, 0x00,
+	0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+
+
+/* Bit n is set if the subtree of tree node n (0 - 127) holds any letter */
+/* A node with a clear bit can never become a letter, however it goes on */
+const unsigned char morse_codeIsAlive[16] = {
+	0xFC, 0xFF, 0xFF, 0xFF, 0xCB, 0x86, 0x67, 0xD3,
+	0x00, 0x30, 0x24, 0x40, 0x02, 0x20, 0x08, 0x01
+};
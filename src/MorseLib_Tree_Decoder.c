@@ -0,0 +1,114 @@
+
+
+/************************************************************************************
+	Implementation of Morse Library Incremental Tree Decoder
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "MorseLib.h"
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	INTER-MODULE FUNCTION DECLARATIONS		/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+/*
+ *
+ * The dichotomic morse tree in heap order, see MorseLib_Symbol_Table.c
+ * morse_codeToAscii gives the letter of a node, morse_codeIsAlive tells
+ * Whether a node has any letter below (or at) it
+ *
+*/
+extern const char morse_codeToAscii[128];
+
+extern const unsigned char morse_codeIsAlive[16];
+
+
+
+
+
+
+
+
+
+
+
+/*///////////////////////////////////////////////////////////////////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////	GLOBAL DECODER FUNCTION IMPLEMENTATIONS	/////////////////////*/
+/*///////////////////											/////////////////////*/
+/*///////////////////////////////////////////////////////////////////////////////////*/
+
+
+
+
+void morse_initTreeDecoder(unsigned char *decoderState) {
+
+	*decoderState = MORSE_TREE_ROOT;
+}
+
+
+
+
+int morse_stepTreeDecoder(unsigned char *decoderState, char morseChar, char *asciiOutput) {
+
+	unsigned int node;
+	int outputCounter;
+	char asciiChar;
+
+	node = *decoderState;
+
+	switch (morseChar) {
+
+		case MORSE_DOT:
+		case MORSE_DASH:
+
+
+			/* Walk one level down: DOT to the left child, DASH to the right child */
+			/* A path that already fell off the tree stays off until the next gap */
+			if (node == MORSE_TREE_OFF) return 0;
+
+			node = (node << 1) | (unsigned int) (morseChar == MORSE_DASH);
+			if (node >= 128 || (morse_codeIsAlive[node >> 3] & (1 << (node & 7))) == 0) {
+				*decoderState = MORSE_TREE_OFF;
+				return -1;
+			}
+
+			*decoderState = (unsigned char) node;
+			return 0;
+
+		case MORSE_LETTER_SEPARATOR:
+		case MORSE_WORD_SEPARATOR:
+
+
+			/* A gap closes the letter, the node we stand on is the letter */
+			outputCounter = 0;
+			*decoderState = MORSE_TREE_ROOT;
+
+			if (node > MORSE_TREE_ROOT) {
+				asciiChar = morse_codeToAscii[node];
+				if (asciiChar == 0) return -1;
+				asciiOutput[outputCounter++] = asciiChar;
+			}
+
+			if (morseChar == MORSE_WORD_SEPARATOR) asciiOutput[outputCounter++] = ' ';
+
+			return outputCounter;
+
+		default:
+			return -1;
+	}
+}
@@ -15,7 +15,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <queue.h>
 #include <bst.h>
 #include "MorseLib.h"
 
@@ -56,17 +55,113 @@ __inline__ int cmp_string(const void *k1, const void *k2) __attribute__((always_
 
 
 
+/*
+ *
+ * Function to allocate a dictionary object through an allocator, and to release it
+ * The release function is used as destructor of every BisTree dictionary, except
+ * For arena objects which are kept until the arena is reset (morse_keepObject)
+ * All are implemented in MorseLib_Allocator.c
+ *
+*/
+void *morse_allocateObject(const MorseAllocator *allocator, size_t objectSize);
+
+void morse_releaseObject(void *object);
+
+void morse_keepObject(void *object);
+
+int morse_isArenaAllocator(const MorseAllocator *allocator);
+
+
+
+/*
+ *
+ * Function to search a flat dictionary by bisection, used by the conversions
+ * Keys are compared like in the BisTree dictionaries (cmp_character / cmp_string)
+ * Returns 0 and the value of the key, -1 if there is no such key
+ *
+*/
+int morse_findDictionaryEntry(const MorseDictionary *dictionary, const char *key,
+								const char **value);
+
+
+
+/*
+ *
+ * Packed morse letter of each ASCII character, see MorseLib_Symbol_Table.c
+ *
+*/
+extern const unsigned char morse_asciiToCode[128];
+
+
+
 /*
  *
  * Internal (Static) function to build dynamic objects of Morse and ASCII characters
- * Using malloc() for dynamic allocation, and then store them
- * To their respective Queue data structure
+ * Using the given allocator for dynamic allocation, and then insert them straight
+ * Into the dictionary, ASCII objects as keys or Morse objects as keys (isMorseKey)
+ * Morse objects are written with the glyphs and separators of the given dialect
+ *
+ * Returns 0 for successful creation, -1 for memory allocation failure
+ *
+*/
+static int morse_buildMorseAsciiObjectList(BisTree *dictionary, int isMorseKey,
+								const MorseDialect *dialect, const MorseAllocator *allocator);
+
+
+
+/*
+ *
+ * Internal (Static) function to build dynamic objects of the four Morse characters
+ * And their Binary strings, and insert them into the dictionary, Morse characters
+ * As keys or Binary strings as keys (isBinaryKey)
+ *
+ * Returns 0 for successful creation, -1 for memory allocation failure
+ *
+*/
+static int morse_buildMorseBinaryObjectList(BisTree *dictionary, int isBinaryKey,
+								const MorseAllocator *allocator);
+
+
+
+/*
+ *
+ * Internal (Static) function to write a native morse string (. - / |)
+ * Using the glyphs and separators of a dialect
+ * If morseOutput is 0, nothing is written and only the length is computed
+ *
+ * Returns length of the written string, without NUL terminator
+ *
+*/
+static int morse_renderDialectString(const char *nativeMorse, const MorseDialect *dialect,
+												char *morseOutput);
+
+
+
+/*
+ *
+ * Internal (Static) function to give the pair number pairIndex of a flat dictionary
+ * In native form: a morse string and the ASCII character or Binary string on the
+ * Other side (isBinary). Letters are the ones of the const symbol tables, which are
+ * The very same symbols morse_buildMorseAsciiObjectList() loads
+ *
+ * Returns 0 for a pair, -1 if pairIndex is past the last pair
+ *
+*/
+static int morse_getFlatPair(int isBinary, int pairIndex, char *nativeMorse, char *otherString);
+
+
+
+/*
+ *
+ * Internal (Static) function to build a flat dictionary in ONE allocation
+ * The first pass only measures the strings, the second one writes them behind the
+ * Entry array and inserts every entry at its sorted place
  *
  * Returns 0 for successful creation, -1 for memory allocation failure
- * Returns thwo Queue data structure containing ASCII and MORSE character objects
  *
 */
-static int morse_buildMorseAsciiObjectList(Queue *asciiQueue, Queue *morseQueue);
+static int morse_buildFlatDictionary(MorseDictionary *dictionary, int isBinary, int isMorseKey,
+								const MorseDialect *dialect, const MorseAllocator *allocator);
 
 
 
@@ -114,10 +209,85 @@ int cmp_string(const void *k1, const void *k2) {
 
 
 
-static int morse_buildMorseAsciiObjectList(Queue *asciiQueue, Queue *morseQueue) {
+int morse_findDictionaryEntry(const MorseDictionary *dictionary, const char *key,
+								const char **value)
+{
+
+	int lowIndex, highIndex, middleIndex, compareValue;
+
+	lowIndex = 0;
+	highIndex = dictionary->entryCount - 1;
+
+	while (lowIndex <= highIndex) {
+
+		middleIndex = (lowIndex + highIndex) / 2;
+		if (dictionary->isCharacterKey == 1)
+			compareValue = cmp_character(key, (dictionary->entries + middleIndex)->key);
+		else
+			compareValue = cmp_string(key, (dictionary->entries + middleIndex)->key);
+
+		if (compareValue == 0) {
+			*value = (dictionary->entries + middleIndex)->value;
+			return 0;
+		}
+
+		if (compareValue < 0) highIndex = middleIndex - 1;
+		else lowIndex = middleIndex + 1;
+	}
+
+	return -1;
+}
+
+
+
+
+/*
+ * The two dialects understood out of the box
+ * Native dialect is what this library always used: .-/.-..|...
+ * Standard dialect is the common notation: .- .-.. / ...
+*/
+const MorseDialect morse_nativeDialect = { ".", "-", "/", "|", 0 };
+const MorseDialect morse_standardDialect = { ".", "-", " ", " / ", 3 };
+
+
+
+
+static int morse_renderDialectString(const char *nativeMorse, const MorseDialect *dialect,
+												char *morseOutput)
+{
+
+	const char *glyph;
+	int glyphLen, outputLen;
+
+	outputLen = 0;
+
+	while (*nativeMorse != '\0') {
+
+		switch (*nativeMorse) {
+			case MORSE_DOT:					glyph = dialect->dotGlyph; break;
+			case MORSE_DASH:				glyph = dialect->dashGlyph; break;
+			case MORSE_LETTER_SEPARATOR:	glyph = dialect->letterSeparator; break;
+			default:						glyph = dialect->wordSeparator; break;
+		}
+
+		glyphLen = strlen(glyph);
+		if (morseOutput != 0)
+			memcpy((void*) (morseOutput + outputLen), (const void*) glyph, glyphLen);
+		outputLen = outputLen + glyphLen;
+		nativeMorse = nativeMorse + 1;
+	}
+
+	return outputLen;
+}
+
+
+
+
+static int morse_buildMorseAsciiObjectList(BisTree *dictionary, int isMorseKey,
+								const MorseDialect *dialect, const MorseAllocator *allocator)
+{
 
 
-	unsigned int isMemoryAllocated;
 	register unsigned int currentIndex;
 	register char *asciiMemorySpace, *currentAsciiChar;
 	register char *morseMemorySpace, *currentMorseString;
@@ -171,30 +341,35 @@ static int morse_buildMorseAsciiObjectList(Queue *asciiQueue, Queue *morseQueue)
 
 
 		/* Request for specified amount of memory to where we copy characters */
-		morseMemorySpace = (char*) malloc(strlen(currentMorseString) + 1);
-		asciiMemorySpace = (char*) malloc(sizeof(char));
+		morseMemorySpace = (char*) morse_allocateObject(allocator,
+					morse_renderDialectString(currentMorseString, dialect, 0) + 1);
+		asciiMemorySpace = (char*) morse_allocateObject(allocator, sizeof(char));
 
 
 		/* Check we've got sufficient amount of memory for what we've requested */
-		/* Just perform Biwtwise AND between two pointer variables*/
-		/* If the result is 0, means any one of them points to 0 */
-		/* Then we did not got some memory, and we return -1 to signal this failure */
-		/* Safely cast our pointer variables to Unsigned Integers, because */
-		/* Memory address can never be negative, it's size is equal to unsigned int */
-		isMemoryAllocated =
-					(unsigned int)asciiMemorySpace & (unsigned int)morseMemorySpace;
-		if
-		(isMemoryAllocated == 0) return -1;
+		/* If any one of them points to 0, give back the other one */
+		/* And we return -1 to signal this failure */
+		if (asciiMemorySpace == 0 || morseMemorySpace == 0) {
+			if (morse_isArenaAllocator(allocator) == 0) {
+				morse_releaseObject((void*) asciiMemorySpace);
+				morse_releaseObject((void*) morseMemorySpace);
+			}
+			return -1;
+		}
 
 
 		/* Copy the necessary characters to the recently allocated memory */
-		strcpy(morseMemorySpace, (const char*) currentMorseString);
+		*(morseMemorySpace +
+			morse_renderDialectString(currentMorseString, dialect, morseMemorySpace)) = '\0';
 		memcpy((void*) asciiMemorySpace, (const void*) currentAsciiChar, sizeof(char));
 
 
-		/* Last step, store the pointer of memory to the specified Queue data structure*/
-		queue_enqueue(asciiQueue, (const void*) asciiMemorySpace);
-		queue_enqueue(morseQueue, (const void*) morseMemorySpace);
+		/* Last step, insert the objects into the Binary Search Tree */
+		/* For BisTree, one object will be a KEY and another object will be the DATA */
+		if (isMorseKey == 1)
+			bst_insert(dictionary, (const void*) morseMemorySpace, (const void*) asciiMemorySpace);
+		else
+			bst_insert(dictionary, (const void*) asciiMemorySpace, (const void*) morseMemorySpace);
 
 
 		/* Then we start again */
@@ -212,6 +387,179 @@ static int morse_buildMorseAsciiObjectList(Queue *asciiQueue, Queue *morseQueue)
 
 
 
+static int morse_buildMorseBinaryObjectList(BisTree *dictionary, int isBinaryKey,
+								const MorseAllocator *allocator)
+{
+
+	register unsigned int currentIndex;
+	char *morseMemorySpace, *binaryMemorySpace;
+
+	const char morseChars[4] = {
+		MORSE_DOT, MORSE_DASH, MORSE_LETTER_SEPARATOR, MORSE_WORD_SEPARATOR
+	};
+
+	const char *binaryStrings[4] = {
+		BINARY_DOT, BINARY_DASH, BINARY_LETTER_SEPARATOR, BINARY_WORD_SEPARATOR
+	};
+
+	for (currentIndex = 0; currentIndex < 4; currentIndex++) {
+
+		morseMemorySpace = (char*) morse_allocateObject(allocator, sizeof(char));
+		binaryMemorySpace = (char*)
+					morse_allocateObject(allocator, strlen(binaryStrings[currentIndex]) + 1);
+
+		if (morseMemorySpace == 0 || binaryMemorySpace == 0) {
+			if (morse_isArenaAllocator(allocator) == 0) {
+				morse_releaseObject((void*) morseMemorySpace);
+				morse_releaseObject((void*) binaryMemorySpace);
+			}
+			return -1;
+		}
+
+		*morseMemorySpace = morseChars[currentIndex];
+		strcpy(binaryMemorySpace, binaryStrings[currentIndex]);
+
+		if (isBinaryKey == 1)
+			bst_insert(dictionary, (const void*) binaryMemorySpace, (const void*) morseMemorySpace);
+		else
+			bst_insert(dictionary, (const void*) morseMemorySpace, (const void*) binaryMemorySpace);
+	}
+
+	return 0;
+}
+
+
+
+
+static int morse_getFlatPair(int isBinary, int pairIndex, char *nativeMorse, char *otherString) {
+
+	register int asciiIndex;
+	int codeLen;
+	unsigned char code;
+
+	const char morseChars[4] = {
+		MORSE_DOT, MORSE_DASH, MORSE_LETTER_SEPARATOR, MORSE_WORD_SEPARATOR
+	};
+
+	const char *binaryStrings[4] = {
+		BINARY_DOT, BINARY_DASH, BINARY_LETTER_SEPARATOR, BINARY_WORD_SEPARATOR
+	};
+
+	if (isBinary == 1) {
+		if (pairIndex >= 4) return -1;
+		*nativeMorse = morseChars[pairIndex];
+		*(nativeMorse + 1) = '\0';
+		strcpy(otherString, binaryStrings[pairIndex]);
+		return 0;
+	}
+
+
+	/* The pairIndex-th ASCII character which has a letter */
+	for (asciiIndex = 0; asciiIndex < 128; asciiIndex++) {
+		if (morse_asciiToCode[asciiIndex] != 0 && pairIndex-- == 0) break;
+	}
+	if (asciiIndex == 128) return -1;
+
+
+	/* Unpack (1 << length) | dashBits, the empty letter of SPACE is a word separator */
+	code = morse_asciiToCode[asciiIndex];
+	for (codeLen = 0; (code >> (codeLen + 1)) != 0; codeLen++) ;
+
+	if (codeLen == 0) {
+		*nativeMorse = MORSE_WORD_SEPARATOR;
+		codeLen = 1;
+	}
+	else {
+		for (pairIndex = 0; pairIndex < codeLen; pairIndex++)
+			*(nativeMorse + pairIndex) =
+					((code >> (codeLen - 1 - pairIndex)) & 1) == 1 ? MORSE_DASH : MORSE_DOT;
+	}
+	*(nativeMorse + codeLen) = '\0';
+
+	*otherString = (char) asciiIndex;
+	*(otherString + 1) = '\0';
+
+	return 0;
+}
+
+
+
+
+static int morse_buildFlatDictionary(MorseDictionary *dictionary, int isBinary, int isMorseKey,
+								const MorseDialect *dialect, const MorseAllocator *allocator)
+{
+
+	register int entryIndex;
+	int entryCount, morseLen, otherLen, compareValue;
+	size_t stringBytes;
+	char nativeMorse[8], otherString[8];
+	char *stringSpace, *morseString;
+	MorseDictionaryEntry newEntry;
+
+	dictionary->entries = 0;
+	dictionary->entryCount = 0;
+	/* Single characters are the ASCII keys, and the morse keys of Binary pairs */
+	dictionary->isCharacterKey = isMorseKey == isBinary ? 1 : 0;
+	dictionary->dialect = dialect;
+	dictionary->allocator = allocator;
+
+
+	/* Measure every pair with its NUL terminators, then take one block for all */
+	entryCount = 0;
+	stringBytes = 0;
+	while (morse_getFlatPair(isBinary, entryCount, nativeMorse, otherString) == 0) {
+		stringBytes += morse_renderDialectString(nativeMorse, dialect, 0) + strlen(otherString) + 2;
+		entryCount = entryCount + 1;
+	}
+
+	dictionary->entries = (MorseDictionaryEntry*) allocator->allocate(allocator->userData,
+								entryCount * sizeof(MorseDictionaryEntry) + stringBytes);
+	if (dictionary->entries == 0) return -1;
+
+	stringSpace = (char*) (dictionary->entries + entryCount);
+
+
+	while (dictionary->entryCount < entryCount) {
+
+		morse_getFlatPair(isBinary, dictionary->entryCount, nativeMorse, otherString);
+
+		/* Morse string first, the other side right behind it */
+		morseString = stringSpace;
+		morseLen = morse_renderDialectString(nativeMorse, dialect, morseString);
+		*(morseString + morseLen) = '\0';
+		otherLen = strlen(otherString);
+		memcpy((void*) (morseString + morseLen + 1), (const void*) otherString, otherLen + 1);
+		stringSpace = stringSpace + morseLen + otherLen + 2;
+
+		newEntry.key = isMorseKey == 1 ? morseString : morseString + morseLen + 1;
+		newEntry.value = isMorseKey == 1 ? morseString + morseLen + 1 : morseString;
+
+
+		/* Insertion sort, larger keys move one place up to make room */
+		for (entryIndex = dictionary->entryCount; entryIndex > 0; entryIndex--) {
+			if (dictionary->isCharacterKey == 1)
+				compareValue = cmp_character(newEntry.key, (dictionary->entries + entryIndex - 1)->key);
+			else
+				compareValue = cmp_string(newEntry.key, (dictionary->entries + entryIndex - 1)->key);
+			if (compareValue >= 0) break;
+			*(dictionary->entries + entryIndex) = *(dictionary->entries + entryIndex - 1);
+		}
+
+		*(dictionary->entries + entryIndex) = newEntry;
+		dictionary->entryCount = dictionary->entryCount + 1;
+	}
+
+	return 0;
+}
+
+
+
+
+
+
+
+
+
 /*///////////////////////////////////////////////////////////////////////////////////*/
 /*///////////////////											/////////////////////*/
 /*///////////////////	GLOBAL UTILITY FUNCTION IMPLEMENTATIONS	/////////////////////*/
@@ -223,193 +571,135 @@ static int morse_buildMorseAsciiObjectList(Queue *asciiQueue, Queue *morseQueue)
 
 int morse_createMorseToBinaryMapping(BisTree *morseToBinary) {
 
-	char cdot, cdash, cspc_l, cspc_w;
-	void *bdot, *bdash, *bspc_l ,*bspc_w;
-	void *kdot, *kdash, *kspc_l, *kspc_w;
+	return morse_createMorseToBinaryMappingWith(morseToBinary, &morse_defaultAllocator);
+}
+
 
-	cdot = MORSE_DOT;
-	cdash = MORSE_DASH;
-	cspc_l = MORSE_LETTER_SEPARATOR;
-	cspc_w = MORSE_WORD_SEPARATOR;
 
-	bdot = malloc(strlen(BINARY_DOT) + 1);
-	bdash = malloc(strlen(BINARY_DASH) + 1);
-	bspc_l = malloc(strlen(BINARY_LETTER_SEPARATOR) + 1);
-	bspc_w = malloc(strlen(BINARY_WORD_SEPARATOR) + 1);
+int morse_createMorseToBinaryMappingWith(BisTree *morseToBinary, const MorseAllocator *allocator) {
 
-	kdot = malloc(sizeof(char));
-	kdash = malloc(sizeof(char));
-	kspc_l = malloc(sizeof(char));
-	kspc_w = malloc(sizeof(char));
+	void (*destroyObject)(void *object);
 
-	strcpy((char*) bdot, BINARY_DOT);
-	strcpy((char*) bdash, BINARY_DASH);
-	strcpy((char*) bspc_l, BINARY_LETTER_SEPARATOR);
-	strcpy((char*) bspc_w, BINARY_WORD_SEPARATOR);
+	/* Dictionary objects come from the allocator, and go back to it on bst_destroy() */
+	destroyObject = morse_isArenaAllocator(allocator) == 1 ? morse_keepObject : morse_releaseObject;
+	bst_init(morseToBinary, cmp_character, destroyObject, destroyObject);
 
-	memcpy(kdot, (void*) &cdot, sizeof(char));
-	memcpy(kdash, (void*) &cdash, sizeof(char));
-	memcpy(kspc_l, (void*) &cspc_l, sizeof(char));
-	memcpy(kspc_w, (void*) &cspc_w, sizeof(char));
+	return morse_buildMorseBinaryObjectList(morseToBinary, 0, allocator);
+}
 
-	bst_init(morseToBinary, cmp_character, free, free);
 
-	bst_insert(morseToBinary, (const void *) kdot, (const void *) bdot);
-	bst_insert(morseToBinary, (const void *) kdash, (const void *) bdash);
-	bst_insert(morseToBinary, (const void *) kspc_l, (const void *) bspc_l);
-	bst_insert(morseToBinary, (const void *) kspc_w, (const void *) bspc_w);
 
-	return 0;
+
+
+int morse_createBinaryToMorseMapping(BisTree *binaryToMorse) {
+
+	return morse_createBinaryToMorseMappingWith(binaryToMorse, &morse_defaultAllocator);
 }
 
 
 
+int morse_createBinaryToMorseMappingWith(BisTree *binaryToMorse, const MorseAllocator *allocator) {
 
+	void (*destroyObject)(void *object);
 
-int morse_createBinaryToMorseMapping(BisTree *binaryToMorse) {
+	destroyObject = morse_isArenaAllocator(allocator) == 1 ? morse_keepObject : morse_releaseObject;
+	bst_init(binaryToMorse, cmp_string, destroyObject, destroyObject);
 
-	char cdot, cdash, cspc_l, cspc_w;
-	void *bdot, *bdash, *bspc_l, *bspc_w;
-	void *kdot, *kdash, *kspc_l, *kspc_w;
+	return morse_buildMorseBinaryObjectList(binaryToMorse, 1, allocator);
+}
 
-	cdot = MORSE_DOT;
-	cdash = MORSE_DASH;
-	cspc_l = MORSE_LETTER_SEPARATOR;
-	cspc_w = MORSE_WORD_SEPARATOR;
 
-	bdot = malloc(strlen(BINARY_DOT) + 1);
-	bdash = malloc(strlen(BINARY_DASH) + 1);
-	bspc_l = malloc(strlen(BINARY_LETTER_SEPARATOR) + 1);
-	bspc_w = malloc(strlen(BINARY_WORD_SEPARATOR) + 1);
 
-	kdot = malloc(sizeof(char));
-	kdash = malloc(sizeof(char));
-	kspc_l = malloc(sizeof(char));
-	kspc_w = malloc(sizeof(char));
+int morse_createAsciiToMorseMapping(BisTree *textToMorse) {
 
-	strcpy((char*) bdot, BINARY_DOT);
-	strcpy((char*) bdash, BINARY_DASH);
-	strcpy((char*) bspc_l, BINARY_LETTER_SEPARATOR);
-	strcpy((char*) bspc_w, BINARY_WORD_SEPARATOR);
+	return morse_createAsciiToMorseMappingWith(textToMorse, &morse_nativeDialect,
+																&morse_defaultAllocator);
+}
 
-	memcpy(kdot, (void*) &cdot, sizeof(char));
-	memcpy(kdash, (void*) &cdash, sizeof(char));
-	memcpy(kspc_l, (void*) &cspc_l, sizeof(char));
-	memcpy(kspc_w, (void*) &cspc_w, sizeof(char));
 
-	bst_init(binaryToMorse, cmp_string, free, free);
 
-	bst_insert(binaryToMorse, (const void *)bdot, (const void *)kdot);
-	bst_insert(binaryToMorse, (const void *)bdash, (const void *)kdash);
-	bst_insert(binaryToMorse, (const void *)bspc_l, (const void *)kspc_l);
-	bst_insert(binaryToMorse, (const void *)bspc_w, (const void *)kspc_w);
+int morse_createAsciiToMorseMappingEx(BisTree *textToMorse, const MorseDialect *dialect) {
 
-	return 0;
+	return morse_createAsciiToMorseMappingWith(textToMorse, dialect, &morse_defaultAllocator);
 }
 
 
 
-int morse_createAsciiToMorseMapping(BisTree *textToMorse) {
+int morse_createAsciiToMorseMappingWith(BisTree *textToMorse, const MorseDialect *dialect,
+											const MorseAllocator *allocator)
+{
 
-	Queue morseQueue, asciiQueue;
-	void *asciiMemorySpace, *morseMemorySpace;
-	int isObjectsBuilt, returnCode;
-
-
-	/* We will copy the pointer addresses contained in these Queue to BisTree */
-	/* For this reason, initialize Queue with NO destructor function */
-	/* Even if they will conatin data which are dynamically initialized */
-	/* Of course, out BisTree will ultimately contain objects which resides */
-	/* On Heap area, so initialize our BisTree with 'free()' as destructor function */
-	queue_init(&morseQueue, 0);
-	queue_init(&asciiQueue, 0);
-	bst_init(textToMorse, cmp_character, free, free);
-
-
-	/* Start building dynamically allocated ASCII and Morse objects */
-	/* And store them on the Queue data structure that we have specified */
-	isObjectsBuilt = morse_buildMorseAsciiObjectList(&asciiQueue, &morseQueue);
-	if
-		(isObjectsBuilt != 0) {
-			returnCode = -1;
-			goto CLEAN_UP;
-		} else {
-			returnCode = 0;
-		}
+	void (*destroyObject)(void *object);
 
-	while (queue_size(&asciiQueue) > 0) {
+	/* ASCII and Morse objects are built and inserted straight into our BisTree */
+	/* They are obtained from the allocator, so initialize our BisTree with */
+	/* 'morse_releaseObject()' as destructor function which gives them back */
+	/* (Arena objects stay where they are until the arena is reset) */
+	destroyObject = morse_isArenaAllocator(allocator) == 1 ? morse_keepObject : morse_releaseObject;
+	bst_init(textToMorse, cmp_character, destroyObject, destroyObject);
+
+	return morse_buildMorseAsciiObjectList(textToMorse, 0, dialect, allocator);
+}
 
 
-		/* First, pull the address of each object from the Queue */
-		/* And store them to the pointer variable specified below */
-		queue_dequeue(&asciiQueue, (void**) &asciiMemorySpace);
-		queue_dequeue(&morseQueue, (void**) &morseMemorySpace);
 
 
-		/* Now insert addresses of pulled objects to the Binary Search Tree */
-		/* For BisTree, one object will be a KEY and another object will be the DATA */
-		bst_insert(textToMorse,
-				(const void *)asciiMemorySpace, (const void *)morseMemorySpace);
-	}
 
-	CLEAN_UP:
-	queue_destroy(&morseQueue);
-	queue_destroy(&asciiQueue);
+int morse_createMorseToAsciiMapping(BisTree *morseToText) {
 
-	return returnCode;
+	return morse_createMorseToAsciiMappingWith(morseToText, &morse_defaultAllocator);
 }
 
 
 
+int morse_createMorseToAsciiMappingWith(BisTree *morseToText, const MorseAllocator *allocator) {
 
+	void (*destroyObject)(void *object);
 
-int morse_createMorseToAsciiMapping(BisTree *morseToText) {
+	destroyObject = morse_isArenaAllocator(allocator) == 1 ? morse_keepObject : morse_releaseObject;
+	bst_init(morseToText, cmp_string, destroyObject, destroyObject);
 
-	Queue morseQueue, asciiQueue;
-	void *asciiMemorySpace, *morseMemorySpace;
-	int isObjectsBuilt, returnCode;
-
-
-	/* We will copy the pointer addresses contained in these Queue to BisTree */
-	/* For this reason, initialize Queue with NO destructor function */
-	/* Even if they will conatin data which are dynamically initialized */
-	/* Of course, out BisTree will ultimately contain objects which resides */
-	/* On Heap area, so initialize our BisTree with 'free()' as destructor function */
-	queue_init(&morseQueue, 0);
-	queue_init(&asciiQueue, 0);
-	bst_init(morseToText, cmp_string, free, free);
-
-
-	/* Start building dynamically allocated ASCII and Morse objects */
-	/* And store them on the Queue data structure that we have specified */
-	isObjectsBuilt = morse_buildMorseAsciiObjectList(&asciiQueue, &morseQueue);
-	if
-		(isObjectsBuilt != 0) {
-			returnCode = -1;
-			goto CLEAN_UP;
-		} else {
-			returnCode = 0;
-		}
+	return morse_buildMorseAsciiObjectList(morseToText, 1, &morse_nativeDialect, allocator);
+}
 
-	while (queue_size(&asciiQueue) > 0) {
 
 
-		/* First, pull the address of each object from the Queue */
-		/* And store them to the pointer variable specified below */
-		queue_dequeue(&asciiQueue, (void**) &asciiMemorySpace);
-		queue_dequeue(&morseQueue, (void**) &morseMemorySpace);
 
 
-		/* Now insert addresses of pulled objects to the Binary Search Tree */
-		/* For BisTree, one object will be a KEY and another object will be the DATA */
-		bst_insert(morseToText,
-				(const void *)morseMemorySpace, (const void *)asciiMemorySpace);
-	}
+int morse_createAsciiToMorseDictionaryWith(MorseDictionary *textToMorse, const MorseDialect *dialect,
+								const MorseAllocator *allocator)
+{
+	return morse_buildFlatDictionary(textToMorse, 0, 0, dialect, allocator);
+}
+
+
+
+int morse_createMorseToAsciiDictionaryWith(MorseDictionary *morseToText, const MorseAllocator *allocator) {
+
+	return morse_buildFlatDictionary(morseToText, 0, 1, &morse_nativeDialect, allocator);
+}
+
 
-	CLEAN_UP:
-	queue_destroy(&morseQueue);
-	queue_destroy(&asciiQueue);
 
-	return returnCode;
+int morse_createMorseToBinaryDictionaryWith(MorseDictionary *morseToBinary, const MorseAllocator *allocator) {
+
+	return morse_buildFlatDictionary(morseToBinary, 1, 1, &morse_nativeDialect, allocator);
 }
 
+
+
+int morse_createBinaryToMorseDictionaryWith(MorseDictionary *binaryToMorse, const MorseAllocator *allocator) {
+
+	return morse_buildFlatDictionary(binaryToMorse, 1, 0, &morse_nativeDialect, allocator);
+}
+
+
+
+void morse_destroyDictionary(MorseDictionary *dictionary) {
+
+	if (dictionary->entries != 0)
+		dictionary->allocator->release(dictionary->allocator->userData, (void*) dictionary->entries);
+
+	dictionary->entries = 0;
+	dictionary->entryCount = 0;
+}
@@ -0,0 +1,118 @@
+
+
+/************************************************************************************
+	Speed report of the Morse Library freestanding profile
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MorseLib.h"
+
+
+
+/*
+ * Runs every dictionary-free conversion and the tree decoder over the same
+ * Text many times, and prints the input throughput of each one. Built for the
+ * Host by "make -f Makefile.embedded bench", to compare releases with each other
+*/
+
+#define BENCH_TEXT_LEN 65536
+#define BENCH_ROUNDS 64
+
+static const char sampleText[] = "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 (+-=/?!.) ";
+
+
+
+static void bench_report(const char *name, clock_t started, long inputBytes) {
+
+	double seconds;
+
+	seconds = (double) (clock() - started) / CLOCKS_PER_SEC;
+	if (seconds <= 0.0) seconds = 1.0 / CLOCKS_PER_SEC;
+
+	printf("%-24s %10.1f MB/s\n", name, inputBytes / seconds / 1000000.0);
+}
+
+
+
+int main(void) {
+
+	char *asciiText, *morseText, *binaryText, *outputText;
+	int asciiLen, morseLen, binaryLen, outputLen, outputCount;
+	register int round, index;
+	unsigned char decoderState;
+	clock_t started;
+
+	asciiText = (char*) malloc(BENCH_TEXT_LEN);
+	morseText = (char*) malloc(BENCH_TEXT_LEN * 8);
+	binaryText = (char*) malloc(BENCH_TEXT_LEN * 32);
+	outputText = (char*) malloc(BENCH_TEXT_LEN * 32);
+	if (asciiText == 0 || morseText == 0 || binaryText == 0 || outputText == 0) return 1;
+
+	asciiLen = BENCH_TEXT_LEN;
+	for (index = 0; index < asciiLen; index++)
+		asciiText[index] = sampleText[index % (sizeof(sampleText) - 1)];
+
+	if (morse_convAsciiToMorseStatic(asciiText, asciiLen, morseText, &morseLen) == -1
+		|| morse_convMorseToBinaryStatic(morseText, morseLen, binaryText, &binaryLen) == -1)
+		return 1;
+
+	printf("Text: %d ASCII, %d morse, %d binary characters, %d rounds\n",
+							asciiLen, morseLen, binaryLen, BENCH_ROUNDS);
+
+
+	started = clock();
+	for (round = 0; round < BENCH_ROUNDS; round++)
+		morse_convAsciiToMorseStatic(asciiText, asciiLen, outputText, &outputLen);
+	bench_report("ASCII to Morse", started, (long) asciiLen * BENCH_ROUNDS);
+
+	started = clock();
+	for (round = 0; round < BENCH_ROUNDS; round++)
+		morse_convMorseToAsciiStatic(morseText, morseLen, outputText, &outputLen);
+	bench_report("Morse to ASCII", started, (long) morseLen * BENCH_ROUNDS);
+
+	started = clock();
+	for (round = 0; round < BENCH_ROUNDS; round++)
+		morse_convMorseToBinaryStatic(morseText, morseLen, outputText, &outputLen);
+	bench_report("Morse to Binary", started, (long) morseLen * BENCH_ROUNDS);
+
+	started = clock();
+	for (round = 0; round < BENCH_ROUNDS; round++)
+		morse_convBinaryToMorseStatic(binaryText, binaryLen, outputText, &outputLen);
+	bench_report("Binary to Morse", started, (long) binaryLen * BENCH_ROUNDS);
+
+	started = clock();
+	for (round = 0; round < BENCH_ROUNDS; round++) {
+		morse_initTreeDecoder(&decoderState);
+		outputLen = 0;
+		for (index = 0; index < morseLen; index++) {
+			outputCount = morse_stepTreeDecoder(&decoderState, morseText[index], outputText + outputLen);
+			if (outputCount > 0) outputLen += outputCount;
+		}
+		outputCount = morse_stepTreeDecoder(&decoderState, MORSE_LETTER_SEPARATOR, outputText + outputLen);
+		if (outputCount > 0) outputLen += outputCount;
+	}
+	bench_report("Tree decoder (per step)", started, (long) morseLen * BENCH_ROUNDS);
+
+	if (outputLen != asciiLen || memcmp(outputText, asciiText, outputLen) != 0) {
+		printf("Tree decoder output differs\n");
+		return 1;
+	}
+
+	free(asciiText);
+	free(morseText);
+	free(binaryText);
+	free(outputText);
+
+	return 0;
+}
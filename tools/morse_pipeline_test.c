@@ -0,0 +1,99 @@
+
+
+/************************************************************************************
+	Regression test of the Morse Library ready made pipeline stages
+	Author:             Ashis Kumar Das
+	Email:              akd.bracu@gmail.com
+	GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "MorseLib_Pipeline.h"
+
+
+
+/*
+ * Feeds streams which can never be completed (a run of '1' longer than 1110, a
+ * Letter longer than any code) into a live pipeline, without closing it, and
+ * Expects the stage to fail instead of waiting for a separator forever
+ *
+ * Build and run with the library sources, its dependencies and POSIX threads:
+ *   gcc -Isrc tools/morse_pipeline_test.c src/MorseLib_*.c -lbst -lstq -lpthread -lm
+*/
+
+#define TEST_STREAM_LEN 12800
+#define TEST_RING_CAPACITY 16
+#define TEST_TIMEOUT_SECONDS 5
+
+
+
+static int test_expectFailure(const char *name, MorseStageFunction firstStage, BisTree *firstState,
+								MorseStageFunction secondStage, BisTree *secondState,
+								char streamChar)
+{
+
+	MorsePipeline pipeline;
+	char stream[TEST_STREAM_LEN], output[64];
+	int pushedLen, pulledLen, failedStage;
+	time_t started;
+
+	memset((void*) stream, streamChar, TEST_STREAM_LEN);
+
+	if (morse_createPipeline(&pipeline, 2, TEST_RING_CAPACITY) == -1) return -1;
+	morse_setPipelineStage(&pipeline, 0, firstStage, (void*) firstState);
+	morse_setPipelineStage(&pipeline, 1, secondStage, (void*) secondState);
+	if (morse_startPipeline(&pipeline, 2) == -1) return -1;
+
+
+	/* The input stays open: only the stage itself can end the pipeline */
+	pushedLen = 0;
+	pulledLen = 0;
+	started = time(0);
+	while (pulledLen != -1 && time(0) - started < TEST_TIMEOUT_SECONDS) {
+		if (pushedLen < TEST_STREAM_LEN)
+			pushedLen += morse_pushPipeline(&pipeline, stream + pushedLen, TEST_STREAM_LEN - pushedLen);
+		pulledLen = morse_pullPipeline(&pipeline, output, sizeof(output));
+	}
+
+	if (pulledLen != -1) morse_closePipeline(&pipeline);
+	morse_joinPipeline(&pipeline);
+	failedStage = pipeline.failedStage;
+	morse_destroyPipeline(&pipeline);
+
+	printf("%-32s pushed %5d, failed stage %2d: %s\n", name, pushedLen, failedStage,
+							pulledLen == -1 && failedStage == 0 ? "ok" : "FAILED");
+
+	return pulledLen == -1 && failedStage == 0 ? 0 : -1;
+}
+
+
+
+int main(void) {
+
+	BisTree binaryToMorse, morseToAscii;
+	int failures;
+
+	if (morse_createBinaryToMorseMapping(&binaryToMorse) == -1
+		|| morse_createMorseToAsciiMapping(&morseToAscii) == -1)
+		return 1;
+
+	failures = 0;
+	if (test_expectFailure("Binary stage, run of '1'", morse_stageBinaryToMorse, &binaryToMorse,
+							morse_stageMorseToAscii, &morseToAscii, '1') == -1)
+		failures = failures + 1;
+	if (test_expectFailure("Morse stage, letter of '.'", morse_stageMorseToAscii, &morseToAscii,
+							morse_stageMorseToAscii, &morseToAscii, MORSE_DOT) == -1)
+		failures = failures + 1;
+
+	bst_destroy(&binaryToMorse);
+	bst_destroy(&morseToAscii);
+
+	return failures == 0 ? 0 : 1;
+}